@@ -0,0 +1,17 @@
+-- Member lists filtered by state and ordered by id
+CREATE INDEX IF NOT EXISTS idx_member_active ON Member (active, id);
+
+-- Duplicate check of createMember and findMemberIdByDetails
+CREATE INDEX IF NOT EXISTS idx_member_details ON Member (lastName, firstName, email, birthDate);
+
+-- Attendance by date. The primary key only covers lookups by member
+CREATE INDEX IF NOT EXISTS idx_attendance_date ON Attendance (date, member_id);
+
+-- junction tables looked up by member. The primary keys lead with the other column
+
+CREATE INDEX IF NOT EXISTS idx_address_member_member ON Address_Member (member_id, address_id);
+
+CREATE INDEX IF NOT EXISTS idx_department_member_member ON Department_Member (member_id, department_id);
+
+-- Collect statistics so the planner can choose between the primary keys and the new indexes
+ANALYZE;
@@ -0,0 +1,65 @@
+-- Counters of the count endpoints, kept exact by the triggers below
+
+CREATE TABLE Stats (
+    name        VARCHAR(50) PRIMARY KEY,
+    value       INTEGER NOT NULL DEFAULT 0
+);
+
+CREATE TABLE MemberStats (
+    member_id   INTEGER PRIMARY KEY,
+    attendances INTEGER NOT NULL DEFAULT 0,
+    FOREIGN KEY (member_id) REFERENCES Member(id)
+);
+
+INSERT INTO Stats (name, value) VALUES
+    ('members',          (SELECT COUNT(*) FROM Member)),
+    ('members_active',   (SELECT COUNT(*) FROM Member WHERE active IS 1)),
+    ('members_inactive', (SELECT COUNT(*) FROM Member WHERE active IS 0)),
+    ('attendances',      (SELECT COUNT(*) FROM Attendance));
+
+INSERT INTO MemberStats (member_id, attendances)
+    SELECT member_id, COUNT(*) FROM Attendance GROUP BY member_id;
+
+-- Member triggers
+
+CREATE TRIGGER stats_member_insert AFTER INSERT ON Member
+BEGIN
+    UPDATE Stats SET value = value + 1 WHERE name = 'members';
+    UPDATE Stats SET value = value + (NEW.active IS 1) WHERE name = 'members_active';
+    UPDATE Stats SET value = value + (NEW.active IS 0) WHERE name = 'members_inactive';
+END;
+
+CREATE TRIGGER stats_member_update AFTER UPDATE OF active ON Member
+BEGIN
+    UPDATE Stats SET value = value + (NEW.active IS 1) - (OLD.active IS 1) WHERE name = 'members_active';
+    UPDATE Stats SET value = value + (NEW.active IS 0) - (OLD.active IS 0) WHERE name = 'members_inactive';
+END;
+
+CREATE TRIGGER stats_member_delete AFTER DELETE ON Member
+BEGIN
+    UPDATE Stats SET value = value - 1 WHERE name = 'members';
+    UPDATE Stats SET value = value - (OLD.active IS 1) WHERE name = 'members_active';
+    UPDATE Stats SET value = value - (OLD.active IS 0) WHERE name = 'members_inactive';
+END;
+
+-- Attendance triggers
+
+CREATE TRIGGER stats_attendance_insert AFTER INSERT ON Attendance
+BEGIN
+    UPDATE Stats SET value = value + 1 WHERE name = 'attendances';
+    INSERT OR IGNORE INTO MemberStats (member_id, attendances) VALUES (NEW.member_id, 0);
+    UPDATE MemberStats SET attendances = attendances + 1 WHERE member_id = NEW.member_id;
+END;
+
+CREATE TRIGGER stats_attendance_update AFTER UPDATE OF member_id ON Attendance
+BEGIN
+    UPDATE MemberStats SET attendances = attendances - 1 WHERE member_id = OLD.member_id;
+    INSERT OR IGNORE INTO MemberStats (member_id, attendances) VALUES (NEW.member_id, 0);
+    UPDATE MemberStats SET attendances = attendances + 1 WHERE member_id = NEW.member_id;
+END;
+
+CREATE TRIGGER stats_attendance_delete AFTER DELETE ON Attendance
+BEGIN
+    UPDATE Stats SET value = value - 1 WHERE name = 'attendances';
+    UPDATE MemberStats SET attendances = attendances - 1 WHERE member_id = OLD.member_id;
+END;
@@ -0,0 +1,5 @@
+-- Day of the birthday (MM-DD) as key of the birthday calendar. SQLite keeps the expression up to date,
+-- queries have to use the exact same expression to find it. Members without a valid birthDate have no key
+CREATE INDEX IF NOT EXISTS idx_member_birthday ON Member (active, strftime('%m-%d', birthDate), id);
+
+ANALYZE idx_member_birthday;
@@ -0,0 +1,4 @@
+-- Duplicate check of createAddress and findAddressByDetails, the equality columns lead, houseNumber completes the duplicate check
+CREATE INDEX IF NOT EXISTS idx_address_details ON Address (street, city, postalCode, country, houseNumber);
+
+ANALYZE idx_address_details;
@@ -4,6 +4,7 @@
 #include "general/asserts.hpp"
 #include "controller/StaticController.hpp"
 #include "controller/MemberController.hpp"
+#include "general/OffloadingHandler.hpp"
 #include "oatpp-swagger/Controller.hpp"
 #include "oatpp/network/Server.hpp"
 #include <iostream>
@@ -41,15 +42,24 @@ namespace primus {
             /* Get router component */
             OATPP_COMPONENT(std::shared_ptr<oatpp::web::server::HttpRouter>, router);
 
+            /* Get server settings and the worker pool, which is nullptr for the synchronous server */
+            OATPP_COMPONENT(std::shared_ptr<primus::component::ServerSettings>, serverSettings);
+            OATPP_COMPONENT(std::shared_ptr<primus::worker::WorkerPool>, workerPool);
+
+            if (serverSettings->isAsync())
+                OATPP_LOGI(logName, "Asynchronous server, endpoints run on %d workers with up to %d waiting requests", static_cast<int>(serverSettings->workers), static_cast<int>(serverSettings->queueSize));
+            else
+                OATPP_LOGI(logName, "Synchronous server, one thread per connection");
+
             OATPP_LOGI(logName, "Adding static endpoints...");
 
             /* Create StaticController and add all of its endpoints to router */
-            router->addController(std::make_shared<StaticController>());
+            auto staticController = primus::http::route(router, StaticController::createShared(), workerPool);
 
             OATPP_LOGI(logName, "Adding member endpoints...");
 
             /* Create MemberController and add all of its endpoints to router */
-            router->addController(std::make_shared<MemberController>());
+            auto memberController = primus::http::route(router, MemberController::createShared(), workerPool);
 
             if (primus::constants::useSwagger)
             {
@@ -58,14 +68,14 @@ namespace primus {
                 /* Swagger UI Endpoint documentation */
                 oatpp::web::server::api::Endpoints docEndpoints;
 
-                docEndpoints.append(router->addController(StaticController::createShared())->getEndpoints());
+                docEndpoints.append(staticController->getEndpoints());
                 OATPP_LOGI(logName, "Collected static endpoints");
 
-                docEndpoints.append(router->addController(MemberController::createShared())->getEndpoints());                     // Add the endpoints of MemberController to the swagger ui documentation
+                docEndpoints.append(memberController->getEndpoints());                     // Add the endpoints of MemberController to the swagger ui documentation
                 OATPP_LOGI(logName, "Collected member endpoints");
 
                 OATPP_LOGI(logName, "Initializing Swagger");
-                router->addController(oatpp::swagger::Controller::createShared(docEndpoints));
+                primus::http::route(router, oatpp::swagger::Controller::createShared(docEndpoints), workerPool);
 
             }
 
@@ -3,6 +3,8 @@
 
 // Oatpp headers
 #include "oatpp/web/server/HttpConnectionHandler.hpp"
+#include "oatpp/web/server/AsyncHttpConnectionHandler.hpp"
+#include "oatpp/core/async/Executor.hpp"
 #include "oatpp/web/server/HttpRouter.hpp"
 #include "oatpp/network/tcp/server/ConnectionProvider.hpp"
 #include "oatpp/parser/json/mapping/ObjectMapper.hpp"
@@ -11,7 +13,17 @@
 // App specific headers
 #include "database/DatabaseComponent.hpp"
 #include "swagger-ui/SwaggerComponent.hpp"
+#include "general/ServerSettings.hpp"
+#include "general/WorkerPool.hpp"
+#include "managers/LeaderboardManager.hpp"
+#include "managers/BirthdayManager.hpp"
+#include "managers/AttendanceIndex.hpp"
+#include "managers/MemberRegistry.hpp"
+#include "managers/FeeManager.hpp"
 #include "managers/MemberManager.hpp"
+#include "managers/StaticManager.hpp"
+#include "managers/AvatarManager.hpp"
+#include "managers/ThumbnailManager.hpp"
 
 namespace primus
 {
@@ -35,19 +47,91 @@ namespace primus
                 return oatpp::network::tcp::server::ConnectionProvider::createShared({ "0.0.0.0", 8000, oatpp::network::Address::IP_4 });
                 }());
 
+            // Create LeaderboardManager component which keeps the attendance ranking in memory. Required by the MemberManager
+            OATPP_CREATE_COMPONENT(std::shared_ptr<primus::managers::Leaderboard::LeaderboardManager>, leaderboardManager)([] {
+                return primus::managers::Leaderboard::LeaderboardManager::createShared();
+                }());
+
+            // Create BirthdayManager component which keeps the birthday calendar in memory. Required by the MemberManager
+            OATPP_CREATE_COMPONENT(std::shared_ptr<primus::managers::Birthday::BirthdayManager>, birthdayManager)([] {
+                return primus::managers::Birthday::BirthdayManager::createShared();
+                }());
+
+            // Create AttendanceIndex component which keeps a bitmap of the attendance days of every member in memory. Required by the MemberManager
+            OATPP_CREATE_COMPONENT(std::shared_ptr<primus::managers::Attendance::AttendanceIndex>, attendanceIndex)([] {
+                return primus::managers::Attendance::AttendanceIndex::createShared();
+                }());
+
+            // Create MemberRegistry component which keeps the ids of all members in memory for existence checks
+            OATPP_CREATE_COMPONENT(std::shared_ptr<primus::managers::Registry::MemberRegistry>, memberRegistry)([] {
+                return primus::managers::Registry::MemberRegistry::createShared();
+                }());
+
+            // Create FeeManager component which calculates the membership fees
+            OATPP_CREATE_COMPONENT(std::shared_ptr<primus::managers::Fee::FeeManager>, feeManager)([] {
+                return primus::managers::Fee::FeeManager::createShared();
+                }());
+
             OATPP_CREATE_COMPONENT(std::shared_ptr<primus::managers::Members::MemberManager>, memberManager)([] {
                 return primus::managers::Members::MemberManager::createShared();
                 }());
 
+            // Create StaticManager component which loads the web directory into memory
+            OATPP_CREATE_COMPONENT(std::shared_ptr<primus::managers::Static::StaticManager>, staticManager)([] {
+                return primus::managers::Static::StaticManager::createShared(WEB_CONTENT_DIRECTORY);
+                }());
+
+            // Create AvatarManager component which caches the profile pictures of the members
+            OATPP_CREATE_COMPONENT(std::shared_ptr<primus::managers::Avatar::AvatarManager>, avatarManager)([] {
+                return primus::managers::Avatar::AvatarManager::createShared(USER_ASSETS);
+                }());
+
+            // Create ThumbnailManager component which creates the thumbnails of the profile pictures in the background
+            OATPP_CREATE_COMPONENT(std::shared_ptr<primus::managers::Thumbnail::ThumbnailManager>, thumbnailManager)([] {
+                return primus::managers::Thumbnail::ThumbnailManager::createShared();
+                }());
+
             // Create Router component
             OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::web::server::HttpRouter>, httpRouter)([] {
                 return oatpp::web::server::HttpRouter::createShared();
                 }());
 
 
+            // Create ServerSettings component which selects the synchronous or the asynchronous server
+            OATPP_CREATE_COMPONENT(std::shared_ptr<ServerSettings>, serverSettings)([] {
+                return std::make_shared<ServerSettings>(ServerSettings::fromEnvironment());
+                }());
+
+            // Create WorkerPool component which runs the endpoints of the asynchronous server. nullptr for the synchronous server
+            OATPP_CREATE_COMPONENT(std::shared_ptr<primus::worker::WorkerPool>, workerPool)([]() -> std::shared_ptr<primus::worker::WorkerPool> {
+                OATPP_COMPONENT(std::shared_ptr<ServerSettings>, settings);
+                if (!settings->isAsync())
+                    return nullptr;
+
+                return primus::worker::WorkerPool::createShared(settings->workers, settings->queueSize);
+                }());
+
+            // Create Executor component which runs the connections of the asynchronous server as coroutines. nullptr for the synchronous server
+            OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::async::Executor>, executor)([]() -> std::shared_ptr<oatpp::async::Executor> {
+                OATPP_COMPONENT(std::shared_ptr<ServerSettings>, settings);
+                if (!settings->isAsync())
+                    return nullptr;
+
+                return std::make_shared<oatpp::async::Executor>(settings->processorThreads,
+                    primus::constants::server::ioThreads, primus::constants::server::timerThreads);
+                }());
+
             // Create ConnectionHandler component which uses Router component to route requests
-            OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::network::ConnectionHandler>, serverConnectionHandler)([] {
+            OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::network::ConnectionHandler>, serverConnectionHandler)([]() -> std::shared_ptr<oatpp::network::ConnectionHandler> {
                 OATPP_COMPONENT(std::shared_ptr<oatpp::web::server::HttpRouter>, router); // get Router component
+                OATPP_COMPONENT(std::shared_ptr<ServerSettings>, settings);
+
+                if (settings->isAsync())
+                {
+                    OATPP_COMPONENT(std::shared_ptr<oatpp::async::Executor>, executor);
+                    return oatpp::web::server::AsyncHttpConnectionHandler::createShared(router, executor);
+                }
+
                 return oatpp::web::server::HttpConnectionHandler::createShared(router);
                 }());
 
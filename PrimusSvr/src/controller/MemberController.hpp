@@ -11,6 +11,19 @@
 #include "general/constants.hpp"
 #include "assert.h"
 #include "general/exceptions.hpp"
+#include "general/cursor.hpp"
+#include "general/date.hpp"
+#include "managers/AvatarManager.hpp"
+#include "managers/LeaderboardManager.hpp"
+#include "managers/BirthdayManager.hpp"
+#include "managers/AttendanceIndex.hpp"
+#include "managers/MemberRegistry.hpp"
+#include "managers/FeeManager.hpp"
+#include "general/StreamBody.hpp"
+#include "dto/EligibilityDto.hpp"
+#include "dto/ProfileDto.hpp"
+#include "dto/MemberBatchDto.hpp"
+#include "dto/FeeDto.hpp"
 
 namespace primus {
     namespace apicontroller {
@@ -41,10 +54,19 @@ namespace primus {
                 using DepartmentPageDto = primus::dto::DepartmentPageDto;
                 using DatePageDto       = primus::dto::DatePageDto      ;
 
+                using MemberBatchDto        = primus::dto::MemberBatchDto       ;
+                using MemberBatchRequestDto = primus::dto::MemberBatchRequestDto;
+
             private:
                 static constexpr const char* logName = primus::constants::apicontroller::member_endpoint::logName;
                 OATPP_COMPONENT(std::shared_ptr<primus::component::DatabaseClient>, m_database);
                 OATPP_COMPONENT(std::shared_ptr<primus::managers::Members::MemberManager>, m_memberManager);
+                OATPP_COMPONENT(std::shared_ptr<primus::managers::Avatar::AvatarManager>, m_avatarManager);
+                OATPP_COMPONENT(std::shared_ptr<primus::managers::Leaderboard::LeaderboardManager>, m_leaderboardManager);
+                OATPP_COMPONENT(std::shared_ptr<primus::managers::Birthday::BirthdayManager>, m_birthdayManager);
+                OATPP_COMPONENT(std::shared_ptr<primus::managers::Attendance::AttendanceIndex>, m_attendanceIndex);
+                OATPP_COMPONENT(std::shared_ptr<primus::managers::Registry::MemberRegistry>, m_memberRegistry);
+                OATPP_COMPONENT(std::shared_ptr<primus::managers::Fee::FeeManager>, m_feeManager);
 
             public:
                 MemberController(OATPP_COMPONENT(std::shared_ptr<ObjectMapper>, objectMapper))
@@ -58,12 +80,40 @@ namespace primus {
                     return std::make_shared<MemberController>(objectMapper);
                 }
 
+            private:
+                /**
+                 * @brief Reads an optional numeric query parameter.
+                 * @return Value of the parameter, defaultValue if it is missing.
+                 */
+                static oatpp::UInt32 getUInt32Parameter(const std::shared_ptr<IncomingRequest>& request, const char* name, v_uint32 defaultValue)
+                {
+                    auto parameter = request->getQueryParameter(name);
+                    if (!parameter)
+                        return defaultValue;
+
+                    bool success = false;
+                    const v_uint32 value = oatpp::utils::conversion::strToUInt32(parameter, success);
+                    OATPP_ASSERT_HTTP(success, Status::CODE_400, "Query parameter '" + oatpp::String(name) + "' is not a valid number");
+
+                    return value;
+                }
+
+                /**
+                 * @brief Reads the optional query parameter offset. Lists paged by cursor do not need it.
+                 * @return Value of the parameter, 0 if it is missing.
+                 */
+                static oatpp::UInt32 getOffsetParameter(const std::shared_ptr<IncomingRequest>& request)
+                {
+                    return getUInt32Parameter(request, "offset", 0);
+                }
+
+            public:
                 ENDPOINT("GET", "/api/v1/members/list/{attribute}", endpoint_member_getMemberListOfAttribute,
-                    PATH(oatpp::String, attribute), QUERY(oatpp::UInt32, limit), QUERY(oatpp::UInt32, offset))
+                    PATH(oatpp::String, attribute), QUERY(oatpp::UInt32, limit), REQUEST(std::shared_ptr<IncomingRequest>, request))
                 {
                     try {
                       auto page = MemberPageDto::createShared();
-                      m_memberManager->getList(page, attribute, limit, offset);
+                      m_memberManager->getList(page, attribute, limit, getOffsetParameter(request), request->getQueryParameter("after"));
 
                       return createDtoResponse(Status::CODE_200, Object<MemberPageDto>(page));
                     }
@@ -84,12 +134,96 @@ namespace primus {
                     info->addTag("List");
                     info->pathParams["attribute"].description = "Attribute to filter members (options: all, active, inactive, birthday)";
                     info->queryParams["limit"].description = "Maximum number of items to return";
-                    info->queryParams["offset"].description = "Number of items to skip before starting to collect the response items";
+                    info->queryParams.add<oatpp::UInt32>("offset").description = "Number of items to skip before starting to collect the response items";
+                    info->queryParams["offset"].required = false;
+                    info->queryParams.add<oatpp::String>("after").description = "Cursor returned as nextCursor of the previous page (lists all, active and inactive). Replaces offset, pages cost the same at any depth";
+                    info->queryParams["after"].required = false;
                     info->addResponse<oatpp::Object<MemberPageDto>>(Status::CODE_200, "application/json");
+                    info->addResponse<Object<StatusDto>>(Status::CODE_400, "application/json");
                     info->addResponse<Object<StatusDto>>(Status::CODE_404, "application/json");
                     info->addResponse<Object<StatusDto>>(Status::CODE_500, "application/json");
                 }
 
+                ENDPOINT("GET", "/api/v1/members/batch", endpoint_member_getMemberBatch,
+                    QUERY(oatpp::String, ids), REQUEST(std::shared_ptr<IncomingRequest>, request))
+                {
+                    try {
+                        OATPP_LOGI(logName, "Received request to get a batch of members");
+
+                        auto batch = m_memberManager->getMemberBatch(primus::managers::Members::MemberManager::parseIds(ids),
+                            primus::managers::Members::MemberManager::splitList(request->getQueryParameter("include")));
+
+                        return createDtoResponse(Status::CODE_200, batch);
+                    }
+                    catch (primus::exceptions::StatusException excep)
+                    {
+                        return createDtoResponse(Status::Status(excep.getStatusDtoObject()->code, excep.getStatusDtoObject()->status->c_str()), Object<primus::dto::StatusDto>(excep.getStatusDtoObject()));
+                    }
+                }
+
+                ENDPOINT_INFO(endpoint_member_getMemberBatch)
+                {
+                    info->name = "getMemberBatch";
+                    info->summary = "Get several members by ID";
+                    info->description = "This endpoint retrieves up to 500 members with a single request, keyed by their ID.";
+                    info->path = "/api/v1/members/batch";
+                    info->method = "GET";
+                    info->addTag("Members");
+                    info->queryParams["ids"].description = "Comma separated IDs of the members";
+                    info->queryParams.add<oatpp::String>("include").description = "Comma separated aggregates to add to every member (options: attendances)";
+                    info->queryParams["include"].required = false;
+                    info->addResponse<Object<MemberBatchDto>>(Status::CODE_200, "application/json");
+                    info->addResponse<Object<StatusDto>>(Status::CODE_400, "application/json");
+                    info->addResponse<Object<StatusDto>>(Status::CODE_500, "application/json");
+                }
+
+                ENDPOINT("POST", "/api/v1/members/batch", endpoint_member_postMemberBatch,
+                    BODY_DTO(Object<MemberBatchRequestDto>, batchRequest))
+                {
+                    OATPP_ASSERT_HTTP(batchRequest->ids != nullptr, Status::CODE_400, "The field 'ids' is required");
+
+                    try {
+                        OATPP_LOGI(logName, "Received request to get a batch of %d members", static_cast<int>(batchRequest->ids->size()));
+
+                        std::vector<v_uint32> ids;
+                        ids.reserve(batchRequest->ids->size());
+                        for (const auto& id : *batchRequest->ids)
+                        {
+                            OATPP_ASSERT_HTTP(id != nullptr, Status::CODE_400, "The field 'ids' must not contain null");
+                            ids.push_back(*id);
+                        }
+
+                        std::vector<std::string> include;
+                        if (batchRequest->include)
+                        {
+                            for (const auto& name : *batchRequest->include)
+                                include.push_back(name ? *name : std::string());
+                        }
+
+                        auto batch = m_memberManager->getMemberBatch(ids, include);
+
+                        return createDtoResponse(Status::CODE_200, batch);
+                    }
+                    catch (primus::exceptions::StatusException excep)
+                    {
+                        return createDtoResponse(Status::Status(excep.getStatusDtoObject()->code, excep.getStatusDtoObject()->status->c_str()), Object<primus::dto::StatusDto>(excep.getStatusDtoObject()));
+                    }
+                }
+
+                ENDPOINT_INFO(endpoint_member_postMemberBatch)
+                {
+                    info->name = "postMemberBatch";
+                    info->summary = "Get several members by ID";
+                    info->description = "Same as GET /api/v1/members/batch, for lists of IDs too long for the URL.";
+                    info->path = "/api/v1/members/batch";
+                    info->method = "POST";
+                    info->addTag("Members");
+                    info->addConsumes<Object<MemberBatchRequestDto>>("application/json");
+                    info->addResponse<Object<MemberBatchDto>>(Status::CODE_200, "application/json");
+                    info->addResponse<Object<StatusDto>>(Status::CODE_400, "application/json");
+                    info->addResponse<Object<StatusDto>>(Status::CODE_500, "application/json");
+                }
+
                 ENDPOINT("UPDATE", "/api/v1/member/{id}/activate", endpoint_member_activate,
                     PATH(oatpp::UInt32, id))
                 {
@@ -100,13 +234,15 @@ namespace primus {
 
                         if (status->code != 200)
                         {
-                            return createDtoResponse(Status::CODE_500, status);
+                            return createDtoResponse(status->code == 404 ? Status::CODE_404 : Status::CODE_500, status);
                         }
                     }
 
                     auto dbResult = m_database->activateMember(id);
                     OATPP_ASSERT_HTTP(dbResult->isSuccess(), Status::CODE_500, "Unknown error");
 
+                    m_birthdayManager->refresh(id);
+
                     OATPP_LOGI(logName, "Member with id: %d activated", id);
                     
 
@@ -126,6 +262,7 @@ namespace primus {
                     info->addTag("Member");
                     info->pathParams["id"].description = "Identifier of the member to activate";
                     info->addResponse<Object<StatusDto>>(Status::CODE_200, "application/json");
+                    info->addResponse<Object<StatusDto>>(Status::CODE_404, "application/json");
                     info->addResponse<Object<StatusDto>>(Status::CODE_500, "application/json");
                 }
 
@@ -139,13 +276,15 @@ namespace primus {
                         auto status = primus::assert::assertMemberExists(id);
                         if (status->code != 200)
                         {
-                            return createDtoResponse(Status::CODE_500, status);
+                            return createDtoResponse(status->code == 404 ? Status::CODE_404 : Status::CODE_500, status);
                         }
                     }
 
                     auto dbResult = m_database->deactivateMember(id);
                     OATPP_ASSERT_HTTP(dbResult->isSuccess(), Status::CODE_500, "UNKNOWN ERROR");
 
+                    m_birthdayManager->refresh(id);
+
                     OATPP_LOGI(logName, "Member with id: %d deactivated", id);
                     
 
@@ -165,6 +304,7 @@ namespace primus {
                     info->addTag("Member");
                     info->pathParams["id"].description = "Identifier of the member to deactivate";
                     info->addResponse<Object<StatusDto>>(Status::CODE_200, "application/json");
+                    info->addResponse<Object<StatusDto>>(Status::CODE_404, "application/json");
                     info->addResponse<Object<StatusDto>>(Status::CODE_500, "application/json");
                 }
 
@@ -174,13 +314,7 @@ namespace primus {
                     
                     OATPP_LOGI(logName, "Received request to get member by id: %d", id.operator v_uint32());
 
-                    auto status = primus::assert::assertMemberExists(id);
-
-                    if (status->code != 200)
-                    {
-                        return createDtoResponse(Status::CODE_500, status);
-                    }
-
+                    // An empty result means the member does not exist, no separate check needed
                     auto dbResult = m_database->getMemberById(id);
 
                     OATPP_ASSERT_HTTP(dbResult->isSuccess(), Status::CODE_500, dbResult->getErrorMessage());
@@ -207,6 +341,46 @@ namespace primus {
                     info->addResponse<Object<StatusDto>>(Status::CODE_500, "application/json");
                 }
 
+                ENDPOINT("GET", "/api/v1/member/{memberId}/profile", endpoint_member_getProfile,
+                    PATH(oatpp::UInt32, memberId), REQUEST(std::shared_ptr<IncomingRequest>, request))
+                {
+                    OATPP_LOGI(logName, "Received request to get the profile of member with id %d", memberId.operator v_uint32());
+
+                    try {
+                        const v_uint32 sections = primus::managers::Members::stringToProfileSections(request->getQueryParameter("fields"));
+                        const oatpp::UInt32 limit = getUInt32Parameter(request, "limit", primus::constants::apicontroller::member_endpoint::profileAttendanceLimit);
+
+                        auto profile = m_memberManager->getProfile(memberId, sections, limit, getOffsetParameter(request));
+
+                        return createDtoResponse(Status::CODE_200, profile);
+                    }
+                    catch (primus::exceptions::StatusException excep)
+                    {
+                        return createDtoResponse(Status::Status(excep.getStatusDtoObject()->code, excep.getStatusDtoObject()->status->c_str()), Object<primus::dto::StatusDto>(excep.getStatusDtoObject()));
+                    }
+                }
+
+                ENDPOINT_INFO(endpoint_member_getProfile)
+                {
+                    info->name = "getMemberProfile";
+                    info->summary = "Get the profile of a member";
+                    info->description = "This endpoint retrieves the member together with the addresses, departments, fee, weapon purchase permission and attendances in a single request. All sections are read from the same state of the database.";
+                    info->path = "/api/v1/member/{memberId}/profile";
+                    info->method = "GET";
+                    info->addTag("Member");
+                    info->pathParams["memberId"].description = "ID of the member";
+                    info->queryParams.add<String>("fields").description = "Comma separated sections to return (options: member, addresses, departments, fee, weaponPurchase, attendanceCount, attendances). All sections if omitted";
+                    info->queryParams["fields"].required = false;
+                    info->queryParams.add<UInt32>("limit").description = "Maximum number of attendances to return. Defaults to 5";
+                    info->queryParams["limit"].required = false;
+                    info->queryParams.add<UInt32>("offset").description = "Number of attendances to skip. Defaults to 0";
+                    info->queryParams["offset"].required = false;
+                    info->addResponse<Object<primus::dto::ProfileDto>>(Status::CODE_200, "application/json");
+                    info->addResponse<Object<StatusDto>>(Status::CODE_400, "application/json");
+                    info->addResponse<Object<StatusDto>>(Status::CODE_404, "application/json");
+                    info->addResponse<Object<StatusDto>>(Status::CODE_500, "application/json");
+                }
+
                 ENDPOINT("POST", "/api/v1/member", endpoint_member_create,
                     BODY_DTO(Object<MemberDto>, member))
                 {
@@ -255,6 +429,12 @@ namespace primus {
                     {
                         OATPP_LOGI(logName, "Created member with id: %d", memberId.operator v_uint32());
 
+                        // A picture might have been stored for this id before, resolve it again on the next request
+                        m_avatarManager->invalidate(memberId);
+
+                        m_birthdayManager->refresh(memberId);
+                        m_memberRegistry->add(memberId);
+
                         dbResult = m_database->getMemberById(memberId);
                         OATPP_ASSERT_HTTP(dbResult->isSuccess(), Status::CODE_500, "Unknown error");
 
@@ -346,6 +526,8 @@ namespace primus {
                     auto dbResult = m_database->updateMember(member);
                     OATPP_ASSERT_HTTP(dbResult->isSuccess(), Status::CODE_500, dbResult->getErrorMessage());
 
+                    m_birthdayManager->refresh(member->id);
+
                     OATPP_LOGI(logName, "Updated member with id: %d", member->id.operator v_uint32());
                     
                     return endpoint_member_getById(member->id);
@@ -369,19 +551,19 @@ namespace primus {
                 {
                     
 
-                    std::shared_ptr<oatpp::orm::QueryResult> dbResult;
+                    primus::component::CachedQueryResult dbResult;
 
                     if (attribute == oatpp::String("all"))
                     {
-                        dbResult = m_database->getMemberCountAll();
+                        dbResult = m_database->countMembersAll();
                     }
                     else if (attribute == oatpp::String("active"))
                     {
-                        dbResult = m_database->getMemberCountActive();
+                        dbResult = m_database->countMembersActive();
                     }
                     else if (attribute == oatpp::String("inactive"))
                     {
-                        dbResult = m_database->getMemberCountInactive();
+                        dbResult = m_database->countMembersInactive();
                     }
                     else
                     {
@@ -396,13 +578,14 @@ namespace primus {
                     }
 
                     OATPP_LOGI(logName, "Received request to get count of %s members", attribute->c_str());
-                    OATPP_ASSERT_HTTP(dbResult->isSuccess(), Status::CODE_500, dbResult->getErrorMessage());
+                    OATPP_ASSERT_HTTP(dbResult.isSuccess(), Status::CODE_500, dbResult.getErrorMessage());
 
-                    auto count = dbResult->fetch<oatpp::Vector<oatpp::Object<UInt32Dto>>>();
+                    auto count = UInt32Dto::createShared();
+                    count->value = static_cast<v_uint32>(dbResult.value);
 
-                    OATPP_LOGI(logName, "Processed request to get count of %s members. Total count: %d", attribute->c_str(), count[0]->value.operator v_uint32());
+                    OATPP_LOGI(logName, "Processed request to get count of %s members. Total count: %d", attribute->c_str(), count->value.operator v_uint32());
                     
-                    return createDtoResponse(Status::CODE_200, count[0]);
+                    return createDtoResponse(Status::CODE_200, count);
                 }
 
                 ENDPOINT_INFO(endpoint_member_countMembers)
@@ -420,14 +603,45 @@ namespace primus {
                     info->addResponse<Object<StatusDto>>(Status::CODE_500, "application/json");
                 }
 
+                ENDPOINT("POST", "/api/v1/members/count/rebuild", endpoint_member_rebuildCounts)
+                {
+                    try {
+                        OATPP_LOGI(logName, "Received request to rebuild the member counters");
+                        m_memberManager->rebuildStats();
+
+                        auto status = primus::dto::StatusDto::createShared();
+                        status->code = 200;
+                        status->message = "Member and attendance counters have been recomputed";
+                        status->status = "Counters rebuilt";
+                        return createDtoResponse(Status::CODE_200, status);
+                    }
+                    catch (primus::exceptions::StatusException excep)
+                    {
+                        return createDtoResponse(Status::Status(excep.getStatusDtoObject()->code, excep.getStatusDtoObject()->status->c_str()), Object<primus::dto::StatusDto>(excep.getStatusDtoObject()));
+                    }
+                }
+
+                ENDPOINT_INFO(endpoint_member_rebuildCounts)
+                {
+                    info->name = "rebuildMemberCounts";
+                    info->summary = "Recompute the member and attendance counters";
+                    info->description = "The counters are maintained by database triggers. This endpoint recomputes them from the tables, which is only needed after the tables were modified outside of the server.";
+                    info->path = "/api/v1/members/count/rebuild";
+                    info->method = "POST";
+                    info->addTag("Members");
+                    info->addTag("Counts");
+                    info->addResponse<Object<StatusDto>>(Status::CODE_200, "application/json");
+                    info->addResponse<Object<StatusDto>>(Status::CODE_500, "application/json");
+                }
+
                 ENDPOINT("GET", "/api/v1/member/{memberId}/count/{attribute}", endpoint_member_countAttribute,
                     PATH(oatpp::UInt32, memberId), PATH(oatpp::String, attribute))
                 {
-                    std::shared_ptr<oatpp::orm::QueryResult> dbResult;
+                    primus::component::CachedQueryResult dbResult;
 
                     if (attribute == oatpp::String("attendances"))
                     {
-                        dbResult = m_database->getCountOfAttendancesOfMember(memberId);
+                        dbResult = m_database->countAttendancesOfMember(memberId);
                     }
                     else
                     {
@@ -441,11 +655,12 @@ namespace primus {
                         return createDtoResponse(Status::CODE_404, status);
                     }
 
-                    OATPP_ASSERT_HTTP(dbResult->isSuccess(), Status::CODE_500, dbResult->getErrorMessage());
+                    OATPP_ASSERT_HTTP(dbResult.isSuccess(), Status::CODE_500, dbResult.getErrorMessage());
 
-                    auto count = dbResult->fetch<oatpp::Vector<oatpp::Object<UInt32Dto>>>();
+                    auto count = UInt32Dto::createShared();
+                    count->value = static_cast<v_uint32>(dbResult.value);
 
-                    return createDtoResponse(Status::CODE_200, count[0]);
+                    return createDtoResponse(Status::CODE_200, count);
                 }
 
                 ENDPOINT_INFO(endpoint_member_countAttribute)
@@ -552,7 +767,7 @@ namespace primus {
 
                     auto memberStatus = primus::assert::assertMemberExists(memberId);
                     if (memberStatus->code != 200)
-                        return createDtoResponse(Status::CODE_500, memberStatus);
+                        return createDtoResponse(memberStatus->code == 404 ? Status::CODE_404 : Status::CODE_500, memberStatus);
 
                     OATPP_LOGI(logName, "Disassociating member and department");
                     dbResult = m_database->disassociateDepartmentFromMember(departmentId, memberId);
@@ -598,7 +813,7 @@ namespace primus {
                     auto status = primus::assert::assertMemberExists(memberId);
                     if (status->code != 200)
                     {
-                        return createDtoResponse(Status::CODE_500, status);
+                        return createDtoResponse(status->code == 404 ? Status::CODE_404 : Status::CODE_500, status);
                     }
 
                     auto dbResult = m_database->createAddress(address);
@@ -646,6 +861,7 @@ namespace primus {
                     info->addTag("Address");
                     info->pathParams["memberId"].description = "ID of the member";
                     info->addResponse<Object<AddressDto>>(Status::CODE_200, "application/json");
+                    info->addResponse<Object<StatusDto>>(Status::CODE_404, "application/json");
                     info->addResponse<Object<StatusDto>>(Status::CODE_500, "application/json");
                 }
 
@@ -672,7 +888,7 @@ namespace primus {
                         auto status = primus::assert::assertMemberExists(memberId);
                         if (status->code != 200)
                         {
-                            return createDtoResponse(Status::CODE_500, status);
+                            return createDtoResponse(status->code == 404 ? Status::CODE_404 : Status::CODE_500, status);
                         }
                     }
 
@@ -721,6 +937,7 @@ namespace primus {
                     info->pathParams["memberId"].description = "ID of the member";
                     info->pathParams["addressId"].description = "ID of the address";
                     info->addResponse<Object<StatusDto>>(Status::CODE_200, "application/json");
+                    info->addResponse<Object<StatusDto>>(Status::CODE_404, "application/json");
                     info->addResponse<Object<StatusDto>>(Status::CODE_500, "application/json");
                 }
 
@@ -731,11 +948,15 @@ namespace primus {
                     OATPP_LOGI(logName, "Received request set member attendance for member with id %d", memberId.operator v_uint32());
                     OATPP_LOGI(logName, "Date of attendance: %s", dateOfAttendance->c_str());
 
+                    // Other formats would be stored and counted, but never be found by the attendance index
+                    int day;
+                    OATPP_ASSERT_HTTP(primus::date::parseDay(*dateOfAttendance, day), Status::CODE_400, "Date of attendance has to be a valid date in the format YYYY-MM-DD");
+
                     {
                         auto status = primus::assert::assertMemberExists(memberId);
 
                         if (status->code != 200)
-                            return createDtoResponse(Status::CODE_500, status);
+                            return createDtoResponse(status->code == 404 ? Status::CODE_404 : Status::CODE_500, status);
                     }
 
                     OATPP_LOGI(logName, "Member found");
@@ -743,12 +964,7 @@ namespace primus {
                     auto dbResult = m_database->createMemberAttendance(memberId, dateOfAttendance);
                     if (!dbResult->isSuccess())
                     {
-                        auto dbResult = m_database->hasMemberAttendedOnDate(memberId, dateOfAttendance);
-                        OATPP_ASSERT_HTTP(dbResult->isSuccess(), Status::CODE_500, dbResult->getErrorMessage());
-                        auto foo = dbResult->getErrorMessage();
-                        auto attendanceOnDate = dbResult->fetch<oatpp::Vector<oatpp::Object<UInt32Dto>>>();
-
-                        if(attendanceOnDate[0]->value > 0)
+                        if(m_attendanceIndex->hasAttended(memberId, *dateOfAttendance))
                         {
                             auto status = primus::dto::StatusDto::createShared();
                             status->code = 403;
@@ -760,6 +976,9 @@ namespace primus {
 
                     OATPP_ASSERT_HTTP(dbResult->isSuccess(), Status::CODE_500, dbResult->getErrorMessage());
 
+                    m_leaderboardManager->addAttendance(memberId, *dateOfAttendance);
+                    m_attendanceIndex->addAttendance(memberId, *dateOfAttendance);
+
                     OATPP_LOGI(logName, "Member attendance was set for date %s", dateOfAttendance->c_str());
 
                     auto status = primus::dto::StatusDto::createShared();
@@ -781,6 +1000,7 @@ namespace primus {
                     info->pathParams["memberId"].description = "ID of the member";
                     info->pathParams["dateOfAttendance"].description = "Date of the attendance (format: YYYY-MM-DD)";
                     info->addResponse<Object<StatusDto>>(Status::CODE_200, "application/json");
+                    info->addResponse<Object<StatusDto>>(Status::CODE_400, "application/json");
                     info->addResponse<Object<StatusDto>>(Status::CODE_404, "application/json");
                     info->addResponse<Object<StatusDto>>(Status::CODE_500, "application/json");
                 }
@@ -792,18 +1012,21 @@ namespace primus {
                     OATPP_LOGI(logName, "Received request remove member attendance for member with id %d", memberId.operator v_uint32());
                     OATPP_LOGI(logName, "Date of attendance: %s", dateOfAttendance->c_str());
 
-                    std::shared_ptr<oatpp::orm::QueryResult> dbResult = m_database->getMemberById(memberId); // Wheather or not the member exists
-                    OATPP_ASSERT_HTTP(dbResult->isSuccess(), Status::CODE_500, dbResult->getErrorMessage());
+                    int day;
+                    OATPP_ASSERT_HTTP(primus::date::parseDay(*dateOfAttendance, day), Status::CODE_400, "Date of attendance has to be a valid date in the format YYYY-MM-DD");
 
-                    auto members = dbResult->fetch<oatpp::Vector<oatpp::Object<MemberDto>>>();
-                    OATPP_ASSERT_HTTP(members->size() > 0, Status::CODE_404, "Member not found");
-                    OATPP_ASSERT_HTTP(members->size() < 2, Status::CODE_500, "Critical database error: more than one member with given id");
+                    auto memberStatus = primus::assert::assertMemberExists(memberId);
+                    if (memberStatus->code != 200)
+                        return createDtoResponse(memberStatus->code == 404 ? Status::CODE_404 : Status::CODE_500, memberStatus);
 
                     OATPP_LOGI(logName, "Member found");
 
-                    dbResult = m_database->deleteMemberAttendance(memberId, dateOfAttendance);
+                    auto dbResult = m_database->deleteMemberAttendance(memberId, dateOfAttendance);
                     OATPP_ASSERT_HTTP(dbResult->isSuccess(), Status::CODE_500, dbResult->getErrorMessage());
 
+                    m_leaderboardManager->removeAttendance(memberId, *dateOfAttendance);
+                    m_attendanceIndex->removeAttendance(memberId, *dateOfAttendance);
+
                     OATPP_LOGI(logName, "Member attendance was removed for date %s", dateOfAttendance->c_str());
 
                     auto status = primus::dto::StatusDto::createShared();
@@ -825,6 +1048,7 @@ namespace primus {
                     info->pathParams["memberId"].description = "ID of the member";
                     info->pathParams["dateOfAttendance"].description = "Date of the attendance (format: YYYY-MM-DD)";
                     info->addResponse<Object<StatusDto>>(Status::CODE_200, "application/json");
+                    info->addResponse<Object<StatusDto>>(Status::CODE_400, "application/json");
                     info->addResponse<Object<StatusDto>>(Status::CODE_404, "application/json");
                     info->addResponse<Object<StatusDto>>(Status::CODE_500, "application/json");
                 }
@@ -832,34 +1056,15 @@ namespace primus {
                 ENDPOINT("GET", "/api/v1/member/{memberId}/fee", endpoint_member_getMemberFee,
                     PATH(oatpp::UInt32, memberId))
                 {
-                    // The department values are nested within this function as they are not used elsewhere
-                    // This function may be changed later on, as we may implement functionality to create new departments
-                    const auto departmentBow     = 1;
-                    const auto departmentAirgun  = 2;
-                    const auto departmentFirearm = 3;
-
-                    enum DepartmentPrices
-                    {
-                        Bogenschiessen = 8,
-                        Luftdruck = 10,
-                        Schusswaffen = 15,
-                        Multiple = 20,
-                        None = 0
-                    };
-
                     OATPP_LOGI(logName, "Received request to calculate the member fee for member with id %d.", memberId.operator v_uint32());
 
                     std::shared_ptr<oatpp::orm::QueryResult> dbResult;
-                    oatpp::Vector<oatpp::Object<MemberDto>> members;
                     oatpp::Vector<oatpp::Object<DepartmentDto>> departments;
                     auto memberFee = UInt32Dto::createShared();
 
-                    dbResult = m_database->getMemberById(memberId);
-                    OATPP_ASSERT_HTTP(dbResult->isSuccess(), Status::CODE_500, dbResult->getErrorMessage());
-
-                    members = dbResult->fetch<oatpp::Vector<oatpp::Object<MemberDto>>>();
-                    OATPP_ASSERT_HTTP(members->size() > 0, Status::CODE_404, "Member not found");
-                    OATPP_ASSERT_HTTP(members->size() < 2, Status::CODE_500, "Critical database error: more than one member with given id");
+                    auto memberStatus = primus::assert::assertMemberExists(memberId);
+                    if (memberStatus->code != 200)
+                        return createDtoResponse(memberStatus->code == 404 ? Status::CODE_404 : Status::CODE_500, memberStatus);
 
                     OATPP_LOGI(logName, "Member was found.", memberId.operator v_uint32());
 
@@ -867,32 +1072,7 @@ namespace primus {
                     OATPP_ASSERT_HTTP(dbResult->isSuccess(), Status::CODE_500, dbResult->getErrorMessage());
                     departments = dbResult->fetch<oatpp::Vector<oatpp::Object<DepartmentDto>>>();
 
-                    if (departments->size() < 1) // No department
-                        memberFee->value = DepartmentPrices::None;
-                    else if (departments->size() > 1) // multiple departments
-                        memberFee->value = DepartmentPrices::Multiple;
-                    else if (departments->size() == 1) // Only one department
-                        switch (departments[0]->id)
-                        {
-                        case departmentBow:
-                            memberFee->value = DepartmentPrices::Bogenschiessen;
-                            break;
-                        case departmentAirgun:
-                            memberFee->value = DepartmentPrices::Luftdruck;
-                            break;
-                        case departmentFirearm:
-                            memberFee->value = DepartmentPrices::Schusswaffen;
-                            break;
-                        }
-                    else
-                    {
-                        auto status = primus::dto::StatusDto::createShared();
-
-                        status->status = "UNKNOWN ERROR";
-                        status->code = 500;
-                        status->message = "Failed while trying to determine membership fee";
-                        return createDtoResponse(Status::CODE_500, status);
-                    }
+                    memberFee->value = primus::managers::Fee::FeeManager::calculateFee(static_cast<v_uint32>(departments->size()), departments->empty() ? 0 : departments[0]->id.operator v_uint32());
 
                     OATPP_LOGI(logName, "Member is in %d departments.", departments->size());
                     OATPP_LOGI(logName, "Fee is %d euro", memberFee->value.operator v_uint32());
@@ -917,21 +1097,66 @@ namespace primus {
                     info->addResponse<Object<StatusDto>>(Status::CODE_500, "application/json");
                 }
 
+                ENDPOINT("GET", "/api/v1/members/fees", endpoint_member_getMemberFees)
+                {
+                    OATPP_LOGI(logName, "Received request for the fees of all active members");
+
+                    // The totals are added up while the pages are read and follow the last member
+                    auto feeManager = m_feeManager;
+                    auto objectMapper = getDefaultObjectMapper();
+                    auto totals = std::make_shared<primus::managers::Fee::FeeTotals>();
+
+                    auto fetchPage = [feeManager, totals](v_uint32 afterId) -> oatpp::Vector<oatpp::Object<primus::dto::MemberFeeDto>> {
+                        auto page = feeManager->getActiveMemberFees(afterId, primus::constants::apicontroller::member_endpoint::reportPageSize);
+                        for (const auto& memberFee : *page)
+                            totals->add(memberFee);
+                        return page;
+                    };
+
+                    auto trailer = [objectMapper, totals](std::string& chunk) {
+                        chunk += ",\"totals\":";
+                        chunk += *objectMapper->writeToString(totals->get());
+                        chunk += '}';
+                    };
+
+                    std::shared_ptr<primus::http::StreamBody> body;
+                    try {
+                        body = primus::http::createKeysetArrayBody<primus::dto::MemberFeeDto>(fetchPage, primus::constants::apicontroller::member_endpoint::reportPageSize, objectMapper, "{\"members\":", trailer);
+                    }
+                    catch (primus::exceptions::StatusException excep)
+                    {
+                        return createDtoResponse(Status::Status(excep.getStatusDtoObject()->code, excep.getStatusDtoObject()->status->c_str()), Object<primus::dto::StatusDto>(excep.getStatusDtoObject()));
+                    }
+
+                    return OutgoingResponse::createShared(Status::CODE_200, body);
+                }
+
+                ENDPOINT_INFO(endpoint_member_getMemberFees)
+                {
+                    info->name = "getMemberFees";
+                    info->summary = "Calculate the member fees of all active members";
+                    info->description = "This endpoint calculates the membership fees of all active members at once, e.g. for the monthly billing. The fees are sorted by id and streamed, followed by the totals per department.";
+                    info->path = "/api/v1/members/fees";
+                    info->method = "GET";
+                    info->addTag("Members");
+                    info->addTag("Fee");
+                    info->addResponse<Object<primus::dto::FeeReportDto>>(Status::CODE_200, "application/json");
+                    info->addResponse<Object<StatusDto>>(Status::CODE_500, "application/json");
+                }
+
                 ENDPOINT("GET", "/api/v1/member/{memberId}/list/{attribute}", endpoint_member_getListOfAttributeForMember,
-                    PATH(oatpp::UInt32, memberId), PATH(oatpp::String, attribute), QUERY(oatpp::UInt32, limit), QUERY(oatpp::UInt32, offset))
+                    PATH(oatpp::UInt32, memberId), PATH(oatpp::String, attribute), QUERY(oatpp::UInt32, limit), REQUEST(std::shared_ptr<IncomingRequest>, request))
                 {
+                    const oatpp::UInt32 offset = getOffsetParameter(request);
+                    const oatpp::String after = request->getQueryParameter("after");
                     
 
                     std::shared_ptr<oatpp::orm::QueryResult> dbResult;
                     std::shared_ptr<OutgoingResponse> ret;
 
-                    {
-                        std::shared_ptr<oatpp::orm::QueryResult> dbResult = m_database->getMemberById(memberId);
-                        OATPP_ASSERT_HTTP(dbResult->isSuccess(), Status::CODE_500, dbResult->getErrorMessage());
-                        oatpp::Vector<oatpp::Object<MemberDto>> members = dbResult->fetch<oatpp::Vector<oatpp::Object<MemberDto>>>();
-                        OATPP_ASSERT_HTTP(members->size() > 0, Status::CODE_404, "Member not found");
-                        OATPP_ASSERT_HTTP(members->size() < 2, Status::CODE_500, "Critical database error: more than one member with given id");
-                    }
+                    auto memberStatus = primus::assert::assertMemberExists(memberId);
+                    if (memberStatus->code != 200)
+                        return createDtoResponse(memberStatus->code == 404 ? Status::CODE_404 : Status::CODE_500, memberStatus);
 
                     if (attribute == oatpp::String("addresses"))
                     {
@@ -942,11 +1167,15 @@ namespace primus {
 
                         auto items = dbResult->fetch<oatpp::Vector<oatpp::Object<AddressDto>>>();
 
+                        auto total = m_database->countAddressesOfMember(memberId);
+                        OATPP_ASSERT_HTTP(total.isSuccess(), Status::CODE_500, total.getErrorMessage());
+
                         auto page = AddressPageDto::createShared();
 
                         page->offset = offset;
                         page->limit = limit;
                         page->count = static_cast<uint32_t>(items->size());
+                        page->total = static_cast<v_uint32>(total.value);
                         page->items = items;
 
                         OATPP_LOGI(logName, "Processed request to get a list of members with %s. Limit: %d, Offset: %d. Returned %d items", attribute->c_str(), limit.operator v_uint32(), offset.operator v_uint32(), page->count.operator v_uint32());
@@ -963,11 +1192,15 @@ namespace primus {
                         auto items = dbResult->fetch<oatpp::Vector<oatpp::Object<DepartmentDto>>>();
 
 
+                        auto total = m_database->countDepartmentsOfMember(memberId);
+                        OATPP_ASSERT_HTTP(total.isSuccess(), Status::CODE_500, total.getErrorMessage());
+
                         auto page = DepartmentPageDto::createShared();
 
                         page->offset = offset;
                         page->limit = limit;
                         page->count = static_cast<uint32_t>(items->size());
+                        page->total = static_cast<v_uint32>(total.value);
                         page->items = items;
 
                         ret = createDtoResponse(Status::CODE_200, page);
@@ -976,18 +1209,35 @@ namespace primus {
                     {
                         OATPP_LOGI(logName, "Received request to get a list attendances associated with member id %d. Limit: %d, Offset: %d", memberId.operator v_uint32(), limit.operator v_uint32(), offset.operator v_uint32());
 
-                        dbResult = m_database->getAttendancesOfMember(memberId, limit, offset);
+                        if (after && !after->empty())
+                        {
+                            std::string beforeDate;
+                            OATPP_ASSERT_HTTP(primus::cursor::decode(after, primus::constants::apicontroller::member_endpoint::cursorAttendances, beforeDate), Status::CODE_400, "The cursor passed as 'after' is malformed or belongs to another list");
+
+                            dbResult = m_database->getAttendancesOfMemberBefore(memberId, beforeDate, limit);
+                        }
+                        else
+                            dbResult = m_database->getAttendancesOfMember(memberId, limit, offset);
+
                         OATPP_ASSERT_HTTP(dbResult->isSuccess(), Status::CODE_500, dbResult->getErrorMessage());
 
                         auto items = dbResult->fetch<oatpp::Vector<oatpp::Object<DateDto>>>();
 
+                        auto total = m_database->countAttendancesOfMember(memberId);
+                        OATPP_ASSERT_HTTP(total.isSuccess(), Status::CODE_500, total.getErrorMessage());
+
                         auto page = DatePageDto::createShared();
 
                         page->offset = offset;
                         page->limit = limit;
                         page->count = static_cast<uint32_t>(items->size());
+                        page->total = static_cast<v_uint32>(total.value);
                         page->items = items;
 
+                        // Attendances are unique per member and date, the date of the last one marks the position in the list
+                        if (!items->empty() && items->size() >= limit.operator v_uint32() && items->back()->date)
+                            page->nextCursor = primus::cursor::encode(primus::constants::apicontroller::member_endpoint::cursorAttendances, items->back()->date);
+
                         ret = createDtoResponse(Status::CODE_200, page);
                     }
                     else
@@ -1022,53 +1272,17 @@ namespace primus {
                         auto status = primus::assert::assertMemberExists(memberId);
 
                         if (status->code != 200)
-                            return createDtoResponse(Status::CODE_500, status);
+                            return createDtoResponse(status->code == 404 ? Status::CODE_404 : Status::CODE_500, status);
                     }
                     OATPP_LOGI(logName, "Member was found");
 
-                    {
-                        std::shared_ptr<oatpp::orm::QueryResult> dbResult;
-                        oatpp::Vector<oatpp::Object<UInt32Dto>> count;
-                        auto ret = BooleanDto::createShared();
-
-                        dbResult = m_database->getCountOfMemberAttendancesInLastYear(memberId);
-                        OATPP_ASSERT_HTTP(dbResult->isSuccess(), Status::CODE_500, dbResult->getErrorMessage());
-                        count = dbResult->fetch<oatpp::Vector<oatpp::Object<UInt32Dto>>>();
+                    // Answered from the attendance index, the database is not involved
+                    auto ret = BooleanDto::createShared();
+                    ret->value = m_memberManager->checkFirearmPurchasePermission(memberId);
 
-                        OATPP_LOGI(logName, "Checking first condition of weapon purchase...");
-                        OATPP_LOGI(logName, "Member attended %d sessions last year.", count[0]->value.operator v_uint32());
-
-                        if (count[0]->value >= 18)
-                        {
-                            ret->value = true;
-                            OATPP_LOGI(logName, "Which allowes him to purchase a weapon");
-                            OATPP_LOGI(logName, "Returning true");
-                        }
-                        else
-                        {
-                            OATPP_LOGI(logName, "Member does not have the yearly attendance to purchase a weapon");
-                            OATPP_LOGI(logName, "Checking for secondary-condition (monthly attendance x1)");
-
-                            dbResult = m_database->countDistinctAttendentMontsWithinLastYear(memberId);
-                            OATPP_ASSERT_HTTP(dbResult->isSuccess(), Status::CODE_500, dbResult->getErrorMessage());
-                            count = dbResult->fetch<oatpp::Vector<oatpp::Object<UInt32Dto>>>();
-
-                            if (count[0]->value == 12)
-                            {
-                                OATPP_LOGI(logName, "Member attended at least one session per month");
-                                OATPP_LOGI(logName, "Returning true");
-                                ret->value = true;
-                            }
-                            else
-                            {
-                                OATPP_LOGI(logName, "Member attended less than one session per month");
-                                OATPP_LOGI(logName, "Returning false");
-                                ret->value = false;
-                            }
-                        }
+                    OATPP_LOGI(logName, "Member is %sallowed to purchase a weapon", ret->value ? "" : "not ");
 
-                        return createDtoResponse(Status::CODE_200, ret);
-                    }
+                    return createDtoResponse(Status::CODE_200, ret);
                 }
 
                 ENDPOINT_INFO(endpoint_member_checkFirearmPurchasePermission)
@@ -1085,6 +1299,45 @@ namespace primus {
                     info->addResponse<Object<StatusDto>>(Status::CODE_404, "application/json");
                     info->addResponse<Object<StatusDto>>(Status::CODE_500, "application/json");
                 }
+
+                ENDPOINT("GET", "/api/v1/members/weaponpurchase/{attribute}", endpoint_member_checkFirearmPurchasePermissionOfMembers,
+                    PATH(oatpp::String, attribute))
+                {
+                    OATPP_LOGI(logName, "Received request to check the weapon purchase permission of %s members", attribute->c_str());
+
+                    auto memberManager = m_memberManager;
+
+                    auto fetchPage = [memberManager, attribute](v_uint32 afterId) -> oatpp::Vector<oatpp::Object<primus::dto::EligibilityDto>> {
+                        return memberManager->getFirearmEligibility(attribute, afterId, primus::constants::apicontroller::member_endpoint::reportPageSize);
+                    };
+
+                    // An unknown attribute is reported with the first page, before the response starts
+                    std::shared_ptr<primus::http::StreamBody> body;
+                    try {
+                        body = primus::http::createKeysetArrayBody<primus::dto::EligibilityDto>(fetchPage, primus::constants::apicontroller::member_endpoint::reportPageSize, getDefaultObjectMapper());
+                    }
+                    catch (primus::exceptions::StatusException excep)
+                    {
+                        return createDtoResponse(Status::Status(excep.getStatusDtoObject()->code, excep.getStatusDtoObject()->status->c_str()), Object<primus::dto::StatusDto>(excep.getStatusDtoObject()));
+                    }
+
+                    return OutgoingResponse::createShared(Status::CODE_200, body);
+                }
+
+                ENDPOINT_INFO(endpoint_member_checkFirearmPurchasePermissionOfMembers)
+                {
+                    info->name = "canMembersBuyWeapon";
+                    info->summary = "Check for all members if they are allowed to purchase a weapon";
+                    info->description = "This endpoint evaluates the rules of canMemberBuyWeapon for all members with the provided attribute at once, e.g. for the yearly report. The results are sorted by id and streamed as a JSON array. Available attributes are: all, active, inactive.";
+                    info->path = "/api/v1/members/weaponpurchase/{attribute}";
+                    info->method = "GET";
+                    info->addTag("Members");
+                    info->addTag("Weapon");
+                    info->pathParams["attribute"].description = "Attribute to filter members (options: all, active, inactive)";
+                    info->addResponse<oatpp::Vector<oatpp::Object<primus::dto::EligibilityDto>>>(Status::CODE_200, "application/json");
+                    info->addResponse<Object<StatusDto>>(Status::CODE_400, "application/json");
+                    info->addResponse<Object<StatusDto>>(Status::CODE_500, "application/json");
+                }
             };
 
 #include OATPP_CODEGEN_END(ApiController)
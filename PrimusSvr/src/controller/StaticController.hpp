@@ -3,11 +3,22 @@
 #include "oatpp/core/macro/component.hpp"
 #include "oatpp/web/protocol/http/outgoing/BufferBody.hpp"
 #include <iostream>
-#include <fstream>
-#include <sstream>
 #include <chrono>
+#include <vector>
 
 #include "general/constants.hpp"
+#include "general/mime.hpp"
+#include "general/hash.hpp"
+#include "general/FileBody.hpp"
+#include "general/SliceBody.hpp"
+#include "general/ConcatBody.hpp"
+#include "general/range.hpp"
+#include "general/ImageUploadWriter.hpp"
+#include "managers/StaticManager.hpp"
+#include "managers/AvatarManager.hpp"
+#include "managers/MemberRegistry.hpp"
+#include "managers/ThumbnailManager.hpp"
+#include "filesystemHelper.hpp"
 
 namespace primus {
     namespace apicontroller {
@@ -21,6 +32,12 @@ namespace primus {
             // |____/ \__\__,_|\__|_|\___|\____\___/|_| |_|\__|_|  \___/|_|_|\___|_|   
             class StaticController : public oatpp::web::server::api::ApiController
             {
+            private:
+                OATPP_COMPONENT(std::shared_ptr<primus::managers::Static::StaticManager>, m_staticManager);
+                OATPP_COMPONENT(std::shared_ptr<primus::managers::Avatar::AvatarManager>, m_avatarManager);
+                OATPP_COMPONENT(std::shared_ptr<primus::managers::Registry::MemberRegistry>, m_memberRegistry);
+                OATPP_COMPONENT(std::shared_ptr<primus::managers::Thumbnail::ThumbnailManager>, m_thumbnailManager);
+
             public:
                 StaticController(OATPP_COMPONENT(std::shared_ptr<ObjectMapper>, objectMapper))
                     : oatpp::web::server::api::ApiController(objectMapper)
@@ -39,6 +56,171 @@ namespace primus {
                     return std::make_shared<StaticController>(objectMapper);
                 }
 
+            private:
+                /**
+                 * @brief Checks the validators sent by the client against the current version of a file.
+                 * If-None-Match takes precedence over If-Modified-Since.
+                 * @param request Incoming request.
+                 * @param etag Entity tag of the current version.
+                 * @param lastModified Last-Modified value of the current version.
+                 * @return True if the client already has the current version.
+                 */
+                static bool isNotModified(const std::shared_ptr<IncomingRequest>& request, const oatpp::String& etag, const oatpp::String& lastModified)
+                {
+                    auto ifNoneMatch = request->getHeader("If-None-Match");
+                    if (ifNoneMatch)
+                    {
+                        const std::string& tags = *ifNoneMatch;
+                        std::size_t start = 0;
+
+                        while (start < tags.size())
+                        {
+                            std::size_t end = tags.find(',', start);
+                            if (end == std::string::npos)
+                                end = tags.size();
+
+                            std::string tag = tags.substr(start, end - start);
+                            tag.erase(0, tag.find_first_not_of(" \t"));
+                            tag.erase(tag.find_last_not_of(" \t") + 1);
+
+                            // If-None-Match uses the weak comparison
+                            if (tag.compare(0, 2, "W/") == 0)
+                                tag.erase(0, 2);
+
+                            if (tag == "*" || tag == *etag)
+                                return true;
+
+                            start = end + 1;
+                        }
+
+                        return false;
+                    }
+
+                    auto ifModifiedSince = request->getHeader("If-Modified-Since");
+                    return ifModifiedSince && *ifModifiedSince == *lastModified;
+                }
+
+                /**
+                 * @brief Adds the validators and caching policy of a file to a response.
+                 */
+                static void putCacheHeaders(const std::shared_ptr<OutgoingResponse>& response, const oatpp::String& etag, const oatpp::String& lastModified, const char* cacheControl)
+                {
+                    response->putHeader("ETag", etag);
+                    response->putHeader("Last-Modified", lastModified);
+                    response->putHeader("Cache-Control", cacheControl);
+                }
+
+                /**
+                 * @brief Creates a 304 response without body.
+                 */
+                static std::shared_ptr<OutgoingResponse> createNotModifiedResponse(const oatpp::String& etag, const oatpp::String& lastModified, const char* cacheControl)
+                {
+                    auto response = OutgoingResponse::createShared(Status::CODE_304, nullptr);
+                    putCacheHeaders(response, etag, lastModified, cacheControl);
+                    return response;
+                }
+
+                /**
+                 * @brief Checks the If-Range header of a request. Ranges are only served if the client still has the current version.
+                 * Entity tags are compared strongly, dates have to match the Last-Modified value exactly.
+                 * @return True if the Range header of the request applies.
+                 */
+                static bool isRangeApplicable(const std::shared_ptr<IncomingRequest>& request, const oatpp::String& etag, const oatpp::String& lastModified)
+                {
+                    auto ifRange = request->getHeader("If-Range");
+                    if (!ifRange)
+                        return true;
+
+                    if (ifRange->compare(0, 1, "\"") == 0)
+                        return *ifRange == *etag;
+
+                    // Weak entity tags never match
+                    if (ifRange->compare(0, 2, "W/") == 0)
+                        return false;
+
+                    return *ifRange == *lastModified;
+                }
+
+                /**
+                 * @brief Creates the body for a part of a file. The data is taken from the cached content or streamed from disk.
+                 */
+                static std::shared_ptr<oatpp::web::protocol::http::outgoing::Body> createPartBody(const std::shared_ptr<const void>& owner, const char* data, const std::string& filePath,
+                    const oatpp::String& contentType, v_int64 offset, v_int64 length)
+                {
+                    if (data)
+                        return primus::http::SliceBody::createShared(owner, data + offset, contentType, length);
+
+                    auto body = primus::http::FileBody::createShared(filePath, contentType, offset, length);
+                    OATPP_ASSERT_HTTP(body, Status::CODE_500, "Failed to open file");
+                    return body;
+                }
+
+                /**
+                 * @brief Creates the response carrying a file and honours the Range and If-Range headers of the request.
+                 * @param request Incoming request.
+                 * @param owner Object owning the data. Kept alive until the response is sent.
+                 * @param data Content of the file in memory or nullptr to stream it from filePath.
+                 * @param filePath Path of the file on disk. Only used if data is nullptr.
+                 * @param length Size of the file in bytes.
+                 * @param contentType Value of the Content-Type header.
+                 * @param etag Entity tag of the current version.
+                 * @param lastModified Last-Modified value of the current version.
+                 * @return 200 with the whole file, 206 with the requested ranges or 416 if none of them can be served.
+                 */
+                static std::shared_ptr<OutgoingResponse> createContentResponse(const std::shared_ptr<IncomingRequest>& request, const std::shared_ptr<const void>& owner, const char* data, const std::string& filePath,
+                    v_int64 length, const oatpp::String& contentType, const oatpp::String& etag, const oatpp::String& lastModified)
+                {
+                    std::vector<primus::http::ByteRange> ranges;
+                    auto result = primus::http::RangeResult::Ignore;
+
+                    auto rangeHeader = request->getHeader("Range");
+                    if (rangeHeader && isRangeApplicable(request, etag, lastModified))
+                        result = primus::http::parseRange(*rangeHeader, length, primus::constants::apicontroller::static_endpoint::maxRanges, ranges);
+
+                    std::shared_ptr<OutgoingResponse> response;
+
+                    if (result == primus::http::RangeResult::Unsatisfiable) {
+                        response = OutgoingResponse::createShared(Status::CODE_416, nullptr);
+                        response->putHeader("Content-Range", "bytes */" + std::to_string(length));
+                    }
+                    else if (result == primus::http::RangeResult::Ignore) {
+                        response = OutgoingResponse::createShared(Status::CODE_200, createPartBody(owner, data, filePath, contentType, 0, length));
+                    }
+                    else if (ranges.size() == 1) {
+                        const auto& range = ranges.front();
+                        response = OutgoingResponse::createShared(Status::CODE_206, createPartBody(owner, data, filePath, contentType, range.first, range.last - range.first + 1));
+                        response->putHeader("Content-Range", "bytes " + std::to_string(range.first) + "-" + std::to_string(range.last) + "/" + std::to_string(length));
+                    }
+                    else {
+                        // The boundary only has to be unlikely to show up in the content
+                        const std::string seed = *etag + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+                        const std::string boundary = "primus-" + primus::hash::toHex(primus::hash::fnv1a64(seed.data(), seed.size()));
+
+                        auto body = std::make_shared<primus::http::ConcatBody>("multipart/byteranges; boundary=" + boundary);
+
+                        for (std::size_t i = 0; i < ranges.size(); ++i) {
+                            const auto& range = ranges[i];
+
+                            std::string partHeader = i == 0 ? "--" : "\r\n--";
+                            partHeader.append(boundary);
+                            partHeader.append("\r\nContent-Type: ").append(*contentType);
+                            partHeader.append("\r\nContent-Range: bytes " + std::to_string(range.first) + "-" + std::to_string(range.last) + "/" + std::to_string(length));
+                            partHeader.append("\r\n\r\n");
+
+                            body->addPart(primus::http::SliceBody::createShared(oatpp::String(std::move(partHeader))));
+                            body->addPart(createPartBody(owner, data, filePath, nullptr, range.first, range.last - range.first + 1));
+                        }
+
+                        body->addPart(primus::http::SliceBody::createShared(oatpp::String("\r\n--" + boundary + "--\r\n")));
+                        response = OutgoingResponse::createShared(Status::CODE_206, body);
+                    }
+
+                    response->putHeader("Accept-Ranges", "bytes");
+                    return response;
+                }
+
+            public:
+
                 ENDPOINT("GET", "/web/*", files,
                     REQUEST(std::shared_ptr<IncomingRequest>, request))
                 {
@@ -51,37 +233,41 @@ namespace primus {
                         pathTail = pathTail->substr(0, queryPos);
                     }
 
-                    std::string filePath(WEB_CONTENT_DIRECTORY);
-                    filePath.append("/");
+                    auto asset = m_staticManager->getAsset(*pathTail);
 
-                    if (pathTail->empty()) {
-                        filePath.append("index.html");
-                    }
-                    else {
-                        filePath.append(*pathTail);
-                    }
+                    if (asset) {
+                        auto variant = primus::managers::Static::StaticManager::selectVariant(*asset, request->getHeader("Accept-Encoding"));
+                        const oatpp::String& etag = variant ? variant->etag : asset->etag;
 
-                    OATPP_LOGI(primus::constants::apicontroller::static_endpoint::logName, "Serving file: %s", filePath.c_str());
+                        if (isNotModified(request, etag, asset->lastModified)) {
+                            OATPP_LOGI(primus::constants::apicontroller::static_endpoint::logName, "File %s not modified", asset->filePath.c_str());
+                            auto response = createNotModifiedResponse(etag, asset->lastModified, primus::constants::apicontroller::static_endpoint::cacheControlWeb);
+                            if (asset->compressible)
+                                response->putHeader("Vary", "Accept-Encoding");
+                            return response;
+                        }
+
+                        auto response = createContentResponse(request, asset, variant ? variant->data : asset->data, asset->filePath,
+                            variant ? variant->contentLength : asset->contentLength, asset->contentType, etag, asset->lastModified);
 
-                    std::ifstream file(filePath, std::ios::binary);
-                    if (file.good()) {
-                        OATPP_LOGI(primus::constants::apicontroller::static_endpoint::logName, "File at %s found", filePath.c_str());
+                        putCacheHeaders(response, etag, asset->lastModified, primus::constants::apicontroller::static_endpoint::cacheControlWeb);
 
-                        std::ostringstream content;
-                        content << file.rdbuf();
-                        file.close();
+                        if (variant)
+                            response->putHeader("Content-Encoding", variant->encoding);
+                        if (asset->compressible)
+                            response->putHeader("Vary", "Accept-Encoding");
 
-                        OATPP_LOGI(primus::constants::apicontroller::static_endpoint::logName, "Processed request to serve file: %s", request->getPathTail()->c_str());
+                        OATPP_LOGI(primus::constants::apicontroller::static_endpoint::logName, "Processed request to serve file: %s", asset->filePath.c_str());
 
-                        return createResponse(Status::CODE_200, content.str());
+                        return response;
                     }
                     else {
-                        OATPP_LOGI(primus::constants::apicontroller::static_endpoint::logName, "File at %s was not found", filePath.c_str());
+                        OATPP_LOGI(primus::constants::apicontroller::static_endpoint::logName, "File %s was not found", pathTail->c_str());
 
                         auto status = primus::dto::StatusDto::createShared();
 
-                        std::string verboseMessage = "File at \"";
-                        verboseMessage.append(filePath.c_str());
+                        std::string verboseMessage = "File \"";
+                        verboseMessage.append(pathTail->c_str());
                         verboseMessage.append("\" could not be found");
 
                         status->code = 404;
@@ -91,6 +277,19 @@ namespace primus {
                     }
                 }
 
+                ENDPOINT("POST", "/api/v1/static/reload", reloadFiles)
+                {
+                    OATPP_LOGI(primus::constants::apicontroller::static_endpoint::logName, "Received request to reload the static file cache");
+
+                    auto count = m_staticManager->reload();
+
+                    auto status = primus::dto::StatusDto::createShared();
+                    status->code = 200;
+                    status->message = "Loaded " + std::to_string(count) + " files from the web directory";
+                    status->status = "Static files reloaded";
+                    return createDtoResponse(Status::CODE_200, status);
+                }
+
 
                 ENDPOINT("GET", "/", root,
                     REQUEST(std::shared_ptr<IncomingRequest>, request))
@@ -107,87 +306,152 @@ namespace primus {
                     return response;
                 }
 
-                ENDPOINT("GET", "/api/member/{memberId}/assets/profilepicture", getAvatar, PATH(oatpp::String, memberId))
+                ENDPOINT("GET", "/api/member/{memberId}/assets/profilepicture", getAvatar, PATH(oatpp::String, memberId),
+                    REQUEST(std::shared_ptr<IncomingRequest>, request))
                 {
                     
                     OATPP_LOGI(primus::constants::apicontroller::static_endpoint::logName, "Received request to serve profile picture for member with id  %s", memberId->c_str());
 
-                    std::string filePath(USER_ASSETS);
-                    std::string finalPath; filePath.append("/");
-                    std::ostringstream content;
-                    int choice;
-
-                    {
-                        auto now = std::chrono::system_clock::now();
-                        auto since_epoch = now.time_since_epoch();
-                        auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(since_epoch).count();
-                        choice = millis % 2;
-                    }
+                    const v_uint32 id = oatpp::utils::conversion::strToUInt32(memberId->c_str());
 
-                    auto userStatus = primus::assert::assertMemberExists(oatpp::utils::conversion::strToUInt32(memberId->c_str()));
+                    // Unknown ids get a default picture. They are neither looked up in the database nor cached, so the cache is bounded by the members
+                    std::shared_ptr<const primus::managers::Static::StaticAsset> avatar;
+                    if (m_memberRegistry->isKnown(id))
+                        avatar = m_avatarManager->getAvatar(id);
+                    else
+                        avatar = m_avatarManager->getDefaultAvatar(id);
 
-                    if (userStatus->code != 200)
+                    if (!avatar)
                     {
-                        OATPP_LOGI(primus::constants::apicontroller::static_endpoint::logName, "User does not exist. Returning default profile picture");
+                        OATPP_LOGE(primus::constants::apicontroller::static_endpoint::logName, "No profile picture to serve for member with id %s", memberId->c_str());
+
+                        auto status = primus::dto::StatusDto::createShared();
 
-                        filePath.append(choice == 1 ? "default-avatar-1.jpg" : "default-avatar-2.jpg");
+                        std::string verboseMessage = "No picture to serve for member with id ";
+                        verboseMessage.append(memberId->c_str());
 
+                        status->code = 404;
+                        status->message = verboseMessage;
+                        status->status = "NOT FOUND";
+                        return createDtoResponse(Status::CODE_404, status);
                     }
-                    else
+
+                    // Serve a thumbnail if a size was requested and it is already available
+                    auto requestedSize = request->getQueryParameter("size");
+                    if (requestedSize)
                     {
-                        OATPP_LOGI(primus::constants::apicontroller::static_endpoint::logName, "User found. Looking for profile picture within directory");
-                        filePath.append(memberId);
-                        filePath.append(".jpg");
+                        v_uint32 size = primus::managers::Thumbnail::ThumbnailManager::selectSize(oatpp::utils::conversion::strToUInt32(requestedSize->c_str()));
+                        if (size != 0)
+                        {
+                            auto thumbnail = m_thumbnailManager->getThumbnail(*avatar, size);
+                            if (thumbnail)
+                                avatar = thumbnail;
+                        }
                     }
 
-                    finalPath = filePath;
+                    OATPP_LOGI(primus::constants::apicontroller::static_endpoint::logName, "Serving file: %s", avatar->filePath.c_str());
 
-                    OATPP_LOGI(primus::constants::apicontroller::static_endpoint::logName, "Serving file: %s", filePath.c_str());
+                    // The default pictures are shared, the entity tag names the member as well as the version of the file
+                    const oatpp::String etag = "\"" + std::to_string(id) + "-" + avatar->etag->substr(1);
 
-                    std::ifstream file(filePath, std::ios::binary);
-                    if (!file.good())
+                    if (isNotModified(request, etag, avatar->lastModified))
                     {
-                        OATPP_LOGI(primus::constants::apicontroller::static_endpoint::logName, "File at %s was not found", filePath.c_str());
+                        OATPP_LOGI(primus::constants::apicontroller::static_endpoint::logName, "File at %s not modified", avatar->filePath.c_str());
+                        return createNotModifiedResponse(etag, avatar->lastModified, primus::constants::apicontroller::static_endpoint::cacheControlAvatar);
+                    }
 
-                        std::string filePath2(USER_ASSETS);
-                        filePath2.append(choice == 1 ? "/default-avatar-1.jpg" : "/default-avatar-2.jpg");
+                    auto response = createContentResponse(request, avatar, avatar->data, avatar->filePath, avatar->contentLength, avatar->contentType, etag, avatar->lastModified);
+                    putCacheHeaders(response, etag, avatar->lastModified, primus::constants::apicontroller::static_endpoint::cacheControlAvatar);
 
-                        finalPath = filePath2;
+                    return response;
+                }
 
-                        std::ifstream file2(filePath2, std::ios::binary);
+                ENDPOINT("PUT", "/api/member/{memberId}/assets/profilepicture", uploadAvatar, PATH(oatpp::UInt32, memberId),
+                    REQUEST(std::shared_ptr<IncomingRequest>, request))
+                {
+                    OATPP_LOGI(primus::constants::apicontroller::static_endpoint::logName, "Received request to store profile picture for member with id %d", memberId.operator v_uint32());
 
-                        OATPP_LOGI(primus::constants::apicontroller::static_endpoint::logName, "Proceeding to serve file %s", filePath2.c_str());
+                    const v_int64 maxSize = primus::constants::apicontroller::static_endpoint::maxAvatarUploadSize;
 
-                        if (!file2.good())
-                        {
-                            OATPP_LOGE(primus::constants::apicontroller::static_endpoint::logName, "Default profile picture not found at %s", filePath2.c_str());
+                    auto memberStatus = primus::assert::assertMemberExists(memberId);
+                    if (memberStatus->code != 200)
+                        return createDtoResponse(memberStatus->code == 404 ? Status::CODE_404 : Status::CODE_500, memberStatus);
 
-                            auto status = primus::dto::StatusDto::createShared();
+                    auto status = primus::dto::StatusDto::createShared();
 
-                            oatpp::String verboseMessage = "No picture to serve. Looked at given paths: ";
-                            verboseMessage->append(filePath);
-                            verboseMessage->append("   |   ");
-                            verboseMessage->append(filePath2);
+                    // Reject announced oversized uploads before reading anything
+                    auto contentLength = request->getHeader("Content-Length");
+                    if (contentLength && oatpp::utils::conversion::strToInt64(contentLength->c_str()) > maxSize)
+                    {
+                        status->code = 413;
+                        status->message = "Pictures may not be larger than " + std::to_string(maxSize) + " bytes";
+                        status->status = "PAYLOAD TOO LARGE";
 
-                            status->code = 404;
-                            status->message = verboseMessage;
-                            status->status = "NOT FOUND";
-                            return createDtoResponse(Status::CODE_404, status);
-                        }
-                        content << file2.rdbuf();
+                        auto response = createDtoResponse(Status::CODE_413, status);
+                        response->putHeader("Connection", "close");
+                        return response;
                     }
-                    else
+
+                    // The body is streamed into a file next to the final one, it is never held in memory as a whole
+                    const std::string temporaryPath = m_avatarManager->getTemporaryPath(memberId);
+                    std::FILE* file = primus::component::filesystem::openFile(temporaryPath, "wb");
+                    OATPP_ASSERT_HTTP(file, Status::CODE_500, "Failed to create temporary file");
+
+                    primus::http::ImageUploadWriter writer(file, maxSize);
+                    request->transferBody(&writer);
+
+                    const bool closed = std::fclose(file) == 0;
+                    auto result = writer.finish();
+
+                    if (result == primus::http::ImageUploadWriter::Result::Ok && !closed)
+                        result = primus::http::ImageUploadWriter::Result::WriteFailed;
+
+                    if (result != primus::http::ImageUploadWriter::Result::Ok)
                     {
-                        content << file.rdbuf();
-                    }
+                        primus::component::filesystem::removeFile(temporaryPath);
 
-                    OATPP_LOGI(primus::constants::apicontroller::static_endpoint::logName, "File at %s found", finalPath.c_str());
+                        switch (result)
+                        {
+                        case primus::http::ImageUploadWriter::Result::TooLarge:
+                        {
+                            status->code = 413;
+                            status->message = "Pictures may not be larger than " + std::to_string(maxSize) + " bytes";
+                            status->status = "PAYLOAD TOO LARGE";
+
+                            // The rest of the body was not read, the connection can not be reused
+                            auto response = createDtoResponse(Status::CODE_413, status);
+                            response->putHeader("Connection", "close");
+                            return response;
+                        }
+                        case primus::http::ImageUploadWriter::Result::WriteFailed:
+                            OATPP_LOGE(primus::constants::apicontroller::static_endpoint::logName, "Failed to write %s", temporaryPath.c_str());
+                            status->code = 500;
+                            status->message = "The picture could not be written to disk";
+                            status->status = "INTERNAL SERVER ERROR";
+                            return createDtoResponse(Status::CODE_500, status);
+                        default:
+                            status->code = 415;
+                            status->message = "Only JPEG and PNG pictures are accepted";
+                            status->status = "UNSUPPORTED MEDIA TYPE";
+                            return createDtoResponse(Status::CODE_415, status);
+                        }
+                    }
 
-                    file.close();
+                    const std::string path = m_avatarManager->storeAvatar(memberId, temporaryPath, writer.getExtension());
+                    if (path.empty())
+                    {
+                        primus::component::filesystem::removeFile(temporaryPath);
+                        OATPP_ASSERT_HTTP(false, Status::CODE_500, "Failed to store picture");
+                    }
 
-                    
+                    // Thumbnails of the previous picture are outdated
+                    m_thumbnailManager->invalidate(path);
+                    m_thumbnailManager->generate(path);
 
-                    return createResponse(Status::CODE_200, content.str());
+                    status->code = 200;
+                    status->message = "Stored picture with " + std::to_string(writer.getReceived()) + " bytes";
+                    status->status = "Profile picture stored";
+                    return createDtoResponse(Status::CODE_200, status);
                 }
 
                 // Endpoint Infos
@@ -196,13 +460,35 @@ namespace primus {
                     info->summary = "Get profile picture for a member";
                     info->path = "/api/member/{memberId}/assets/profilepicture";
                     info->pathParams.add("memberId", oatpp::String::Class::getType());
+                    info->queryParams.add("size", oatpp::UInt32::Class::getType());
+                    info->queryParams["size"].description = "Optional edge length in pixels. The smallest thumbnail at least this large is served, the original picture if there is none yet";
+                    info->queryParams["size"].required = false;
                     info->addResponse<String>(Status::CODE_200, "image/jpeg");
+                    info->addResponse<String>(Status::CODE_304, "image/jpeg");
+                    info->addResponse<String>(Status::CODE_206, "image/jpeg");
+                    info->addResponse<String>(Status::CODE_416, "text/plain");
                     info->addResponse<Object<primus::dto::StatusDto>>(Status::CODE_404, "application/json");
                     info->addTag("Member");
                     info->addTag("Static File");
                 }
 
 
+                ENDPOINT_INFO(uploadAvatar) {
+                    info->summary = "Store the profile picture of a member";
+                    info->description = "The body is the picture itself (JPEG or PNG). Thumbnails are created in the background afterwards.";
+                    info->path = "/api/member/{memberId}/assets/profilepicture";
+                    info->pathParams.add("memberId", oatpp::UInt32::Class::getType());
+                    info->addConsumes<String>("image/jpeg");
+                    info->addConsumes<String>("image/png");
+                    info->addResponse<Object<primus::dto::StatusDto>>(Status::CODE_200, "application/json");
+                    info->addResponse<Object<primus::dto::StatusDto>>(Status::CODE_404, "application/json");
+                    info->addResponse<Object<primus::dto::StatusDto>>(Status::CODE_413, "application/json");
+                    info->addResponse<Object<primus::dto::StatusDto>>(Status::CODE_415, "application/json");
+                    info->addResponse<Object<primus::dto::StatusDto>>(Status::CODE_500, "application/json");
+                    info->addTag("Member");
+                    info->addTag("Static File");
+                }
+
                 ENDPOINT_INFO(files)
                 {
                     info->name = "files";
@@ -213,9 +499,23 @@ namespace primus {
                     info->addTag("Static File");
                     info->pathParams["*"].description = "File path relative to the '/web' directory";
                     info->addResponse<String>(Status::CODE_200, "text/html");
+                    info->addResponse<String>(Status::CODE_304, "text/html");
+                    info->addResponse<String>(Status::CODE_206, "multipart/byteranges");
+                    info->addResponse<String>(Status::CODE_416, "text/plain");
                     info->addResponse<Object<primus::dto::StatusDto>>(Status::CODE_404, "application/json");
                 }
 
+                ENDPOINT_INFO(reloadFiles)
+                {
+                    info->name = "reloadFiles";
+                    info->summary = "Reload static files";
+                    info->description = "This endpoint drops the in-memory cache of static files and loads the '/web' directory again.";
+                    info->path = "/api/v1/static/reload";
+                    info->method = "POST";
+                    info->addTag("Static File");
+                    info->addResponse<Object<primus::dto::StatusDto>>(Status::CODE_200, "application/json");
+                }
+
                 ENDPOINT_INFO(root)
                 {
                     info->name = "root";
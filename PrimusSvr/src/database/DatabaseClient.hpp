@@ -8,6 +8,7 @@
 
 #include "dto/DatabaseDtos.hpp"
 #include "general/constants.hpp"
+#include "RoutingExecutor.hpp"
 
 namespace primus
 {
@@ -27,24 +28,46 @@ namespace primus
             typedef primus::dto::database::AddressDto       AddressDto;
             typedef primus::dto::database::DepartmentDto    DepartmentDto;
             typedef primus::dto::database::MemberDto        MemberDto;
+
+        private:
+            std::shared_ptr<RoutingExecutor> m_routingExecutor;
+
+            static int bindNothing(sqlite3_stmt*)
+            {
+                return SQLITE_OK;
+            }
+
         public:
             /**
              * Constructor to initialize the DatabaseClient.
-             * @param executor - shared pointer to oatpp executor.
+             * @param executor - shared pointer to the executor routing reads and writes.
              */
-            DatabaseClient(const std::shared_ptr<oatpp::orm::Executor>& executor)
+            DatabaseClient(const std::shared_ptr<RoutingExecutor>& executor)
                 : oatpp::orm::DbClient(executor)
+                , m_routingExecutor(executor)
             {
                 OATPP_LOGI(primus::constants::databaseclient::logName, "DatabaseClient(oatpp::orm::DbClient) initialized");
 
                 oatpp::orm::SchemaMigration migration(executor);
                 migration.addFile(1 /* start from version 1 */, DATABASE_MIGRATIONS "/001_init.sql");
+                migration.addFile(2, DATABASE_MIGRATIONS "/002_indexes.sql");
+                migration.addFile(3, DATABASE_MIGRATIONS "/003_stats.sql");
+                migration.addFile(4, DATABASE_MIGRATIONS "/004_birthdays.sql");
+                migration.addFile(5, DATABASE_MIGRATIONS "/005_address_index.sql");
                 migration.migrate(); // <-- run migrations. This guy will throw on error.
 
                 auto version = executor->getSchemaVersion();
                 OATPP_LOGI(primus::constants::databaseclient::logName,"Migration - OK. Version=%lld.", version);
             }
 
+            /**
+            * Begins a transaction on a read-only connection, see RoutingExecutor::beginReadTransaction
+            */
+            oatpp::orm::Transaction beginReadTransaction()
+            {
+                return m_routingExecutor->beginReadTransaction();
+            }
+
             //                           _               
             //  _ __ ___   ___ _ __ ___ | |__   ___ _ __ 
             // | '_ ` _ \ / _ \ '_ ` _ \| '_ \ / _ \ '__|
@@ -59,6 +82,25 @@ namespace primus
             */
             QUERY(getMemberById, "SELECT * from Member WHERE id = :id;", PARAM(oatpp::UInt32, id));
 
+            /**
+            * Checks whether a member with the given id exists, value is 1 if so and 0 otherwise. Runs on a cached prepared statement
+            * and only probes the primary key, see MemberRegistry
+            *
+            * @param id The member id
+            *
+            */
+            CachedQueryResult existsMemberById(v_uint32 id)
+            {
+                return m_routingExecutor->executeCached("existsMemberById", "SELECT 1 FROM Member WHERE id = ?1;", [id](sqlite3_stmt* statement) {
+                    return sqlite3_bind_int64(statement, 1, id);
+                    });
+            }
+
+            /**
+            * Ids of all members, see MemberRegistry
+            */
+            QUERY(getAllMemberIds, "SELECT id as value FROM Member;");
+
 
             /**
             * Creates a member in the database
@@ -102,11 +144,29 @@ namespace primus
             // | | | | | |  __/ | | | | | |_) |  __/ |    | (_| (_) | |_| | | | | |_\__ \
             // |_| |_| |_|\___|_| |_| |_|_.__/ \___|_|     \___\___/ \__,_|_| |_|\__|___/
 
-            QUERY(getMemberCountAll, "SELECT COUNT(*) as value FROM Member");
+            // The counts are maintained by the triggers of 003_stats.sql
+            QUERY(getMemberCountAll, "SELECT value FROM Stats WHERE name = 'members'");
 
-            QUERY(getMemberCountActive, "SELECT COUNT(*) as value FROM Member WHERE active=1");
+            QUERY(getMemberCountActive, "SELECT value FROM Stats WHERE name = 'members_active'");
 
-            QUERY(getMemberCountInactive, "SELECT COUNT(*) as value FROM Member WHERE active=0");
+            QUERY(getMemberCountInactive, "SELECT value FROM Stats WHERE name = 'members_inactive'");
+
+            /**
+            * Recomputes the counters of 003_stats.sql from the tables, repairing any drift.
+            * Has to run in a single transaction, see MemberManager::rebuildStats
+            */
+            QUERY(rebuildStats,
+                " INSERT OR REPLACE INTO Stats (name, value) VALUES "
+                " ('members',          (SELECT COUNT(*) FROM Member)), "
+                " ('members_active',   (SELECT COUNT(*) FROM Member WHERE active IS 1)), "
+                " ('members_inactive', (SELECT COUNT(*) FROM Member WHERE active IS 0)), "
+                " ('attendances',      (SELECT COUNT(*) FROM Attendance));");
+
+            QUERY(clearMemberStats, "DELETE FROM MemberStats;");
+
+            QUERY(rebuildMemberStats,
+                " INSERT INTO MemberStats (member_id, attendances) "
+                " SELECT member_id, COUNT(*) FROM Attendance GROUP BY member_id;");
 
             //                           _                 _ _     _       
             //  _ __ ___   ___ _ __ ___ | |__   ___ _ __  | (_)___| |_ ___ 
@@ -114,16 +174,23 @@ namespace primus
             // | | | | | |  __/ | | | | | |_) |  __/ |    | | \__ \ |_\__ \
             // |_| |_| |_|\___|_| |_| |_|_.__/ \___|_|    |_|_|___/\__|___/
 
-            QUERY(getMembersWithUpcomingBirthday,
-                " SELECT * from Member m "
-                " WHERE active = 1 AND strftime('%m-%d', m.birthDate) >= strftime('%m-%d', 'now') "
-                " ORDER BY strftime('%m-%d', m.birthDate) ASC "
-                " LIMIT :limit OFFSET :offset; ",
-                PARAM(oatpp::UInt32, limit),
-                PARAM(oatpp::UInt32, offset));
+            /**
+            * Birthdays of all active members in calendar order, see BirthdayManager.
+            * The expression has to match idx_member_birthday of 004_birthdays.sql
+            */
+            QUERY(getActiveMemberBirthdays,
+                " SELECT id as memberId, strftime('%m-%d', birthDate) as day FROM Member "
+                " WHERE active = 1 AND strftime('%m-%d', birthDate) IS NOT NULL "
+                " ORDER BY strftime('%m-%d', birthDate), id;");
+
+            QUERY(getActiveMemberBirthday,
+                " SELECT id as memberId, strftime('%m-%d', birthDate) as day FROM Member "
+                " WHERE id = :id AND active = 1 AND strftime('%m-%d', birthDate) IS NOT NULL;",
+                PARAM(oatpp::UInt32, id));
 
             QUERY(getAllMembers,
                 " SELECT * FROM Member "
+                " ORDER BY id "
                 " LIMIT :limit OFFSET :offset;",
                 PARAM(oatpp::UInt32, limit),
                 PARAM(oatpp::UInt32, offset));
@@ -136,17 +203,22 @@ namespace primus
                 PARAM(oatpp::UInt32, limit),
                 PARAM(oatpp::UInt32, offset));
 
+            /**
+            * The members with the most attendances within the last six months.
+            * Without statistics the planner groups along the primary key of Attendance and reads all attendances ever recorded
+            */
             QUERY(getMembersByMostTraining,
                 " SELECT m.* "
                 " FROM Member m "
                 " JOIN( "
                 "     SELECT member_id, COUNT(*) AS attendance_count "
-                "     FROM Attendance"
+                "     FROM Attendance INDEXED BY idx_attendance_date "
                 "     WHERE date >= date('now', '-6 months') "
                 "     GROUP BY member_id "
-                "     ORDER BY attendance_count DESC "
+                "     ORDER BY attendance_count DESC, member_id "
                 "     LIMIT :limit OFFSET :offset "
-                " ) AS top_members ON m.id = top_members.member_id; ",
+                " ) AS top_members ON m.id = top_members.member_id "
+                " ORDER BY top_members.attendance_count DESC, m.id; ",
                 PARAM(oatpp::UInt32, limit),
                 PARAM(oatpp::UInt32, offset));
 
@@ -158,6 +230,74 @@ namespace primus
                 PARAM(oatpp::UInt32, limit),
                 PARAM(oatpp::UInt32, offset));
 
+            /**
+            * Keyset variants of the member lists. Return the members following the member with id afterId
+            *
+            * @param afterId Id of the last member of the previous page, 0 for the first page
+            * @param limit Maximum count of members
+            *
+            */
+            QUERY(getAllMembersAfter,
+                " SELECT * FROM Member "
+                " WHERE id > :afterId "
+                " ORDER BY id "
+                " LIMIT :limit;",
+                PARAM(oatpp::UInt32, afterId),
+                PARAM(oatpp::UInt32, limit));
+
+            QUERY(getActiveMembersAfter,
+                " SELECT * FROM Member "
+                " WHERE active = 1 AND id > :afterId "
+                " ORDER BY id "
+                " LIMIT :limit;",
+                PARAM(oatpp::UInt32, afterId),
+                PARAM(oatpp::UInt32, limit));
+
+            QUERY(getInactiveMembersAfter,
+                " SELECT * FROM Member "
+                " WHERE active = 0 AND id > :afterId "
+                " ORDER BY id "
+                " LIMIT :limit;",
+                PARAM(oatpp::UInt32, afterId),
+                PARAM(oatpp::UInt32, limit));
+
+            /**
+            * Totals of the member lists, running on cached prepared statements. Read from the counters of 003_stats.sql if available,
+            * the others are covered by the indexes of 002_indexes.sql
+            */
+            CachedQueryResult countMembersAll(void)
+            {
+                return m_routingExecutor->executeCached("countMembersAll", "SELECT value FROM Stats WHERE name = 'members';", bindNothing);
+            }
+
+            CachedQueryResult countMembersActive(void)
+            {
+                return m_routingExecutor->executeCached("countMembersActive", "SELECT value FROM Stats WHERE name = 'members_active';", bindNothing);
+            }
+
+            CachedQueryResult countMembersInactive(void)
+            {
+                return m_routingExecutor->executeCached("countMembersInactive", "SELECT value FROM Stats WHERE name = 'members_inactive';", bindNothing);
+            }
+
+            /**
+            * Fetches the members of a comma separated list of ids, e.g. "3,1,2", in the order of the list.
+            * Unknown ids are skipped. Every member is looked up by its primary key.
+            */
+            QUERY(getMembersByIds,
+                " SELECT m.* FROM ( "
+                "     WITH RECURSIVE ids(position, id, rest) AS ( "
+                "         SELECT 0, NULL, :ids || ',' "
+                "         UNION ALL "
+                "         SELECT position + 1, CAST(substr(rest, 1, instr(rest, ',') - 1) AS INTEGER), substr(rest, instr(rest, ',') + 1) "
+                "         FROM ids WHERE rest <> '' "
+                "     ) "
+                "     SELECT position, id FROM ids WHERE id IS NOT NULL "
+                " ) AS list "
+                " JOIN Member m ON m.id = list.id "
+                " ORDER BY list.position;",
+                PARAM(oatpp::String, ids));
+
             QUERY(getMembersByAddress, "SELECT Member.* FROM Member INNER JOIN Address_Member ON Member.id = Address_Member.member_id WHERE Address_Member.address_id = :addressId;", PARAM(oatpp::UInt32, addressId));
             
             QUERY(getMembersByDepartment, "SELECT Member.* FROM Member INNER JOIN Department_Member ON Member.id = Department_Member.member_id WHERE Department_Member.department_id = :departmentId;", PARAM(oatpp::UInt32, departmentId));
@@ -170,8 +310,9 @@ namespace primus
 
             QUERY(getDepartmentsOfMember,
                 "SELECT d.* FROM Department d "
-                "JOIN MemberDepartmentRel mdr ON d.id = mdr.departmentID "
-                "WHERE mdr.memberID = :id;",
+                "JOIN Department_Member dm ON d.id = dm.department_id "
+                "WHERE dm.member_id = :id "
+                "ORDER BY dm.department_id;",
                 PARAM(oatpp::UInt32, id));
 
             QUERY(getMemberAddresses,
@@ -184,11 +325,44 @@ namespace primus
                 PARAM(oatpp::UInt32, limit),
                 PARAM(oatpp::UInt32, offset));
 
+            /**
+            * Totals of the lists of a member, running on cached prepared statements
+            *
+            * @param memberId The member id
+            *
+            */
+            CachedQueryResult countAddressesOfMember(v_uint32 memberId)
+            {
+                return m_routingExecutor->executeCached("countAddressesOfMember", "SELECT COUNT(*) FROM Address_Member WHERE member_id = ?1;", [memberId](sqlite3_stmt* statement) {
+                    return sqlite3_bind_int64(statement, 1, memberId);
+                    });
+            }
+
+            CachedQueryResult countDepartmentsOfMember(v_uint32 memberId)
+            {
+                return m_routingExecutor->executeCached("countDepartmentsOfMember", "SELECT COUNT(*) FROM Department_Member WHERE member_id = ?1;", [memberId](sqlite3_stmt* statement) {
+                    return sqlite3_bind_int64(statement, 1, memberId);
+                    });
+            }
+
+            /**
+            * Totals of the addresses, departments and attendances of a member at once, see the member profile
+            *
+            * @param id The member id
+            *
+            */
+            QUERY(getProfileCountsOfMember,
+                " SELECT "
+                " (SELECT COUNT(*) FROM Address_Member WHERE member_id = :id) as addresses, "
+                " (SELECT COUNT(*) FROM Department_Member WHERE member_id = :id) as departments, "
+                " IFNULL((SELECT attendances FROM MemberStats WHERE member_id = :id), 0) as attendances;",
+                PARAM(oatpp::UInt32, id));
+
             QUERY(getMemberDepartments,
                 " SELECT d.* FROM Department d "
                 " INNER JOIN Department_Member dm ON d.id = dm.department_id "
                 " WHERE dm.member_id = :id "
-                " ORDER BY d.id ASC"
+                " ORDER BY dm.department_id ASC"
                 " LIMIT :limit OFFSET :offset;",
                 PARAM(oatpp::UInt32, id),
                 PARAM(oatpp::UInt32, limit),
@@ -224,8 +398,9 @@ namespace primus
             QUERY(updateAddress,
                 "UPDATE Address SET "
                 "street = :address.street, "
+                "houseNumber = :address.houseNumber, "
                 "city = :address.city, "
-                "zipCode = :address.zipCode, "
+                "postalCode = :address.postalCode, "
                 "country = :address.country "
                 "WHERE id = :address.id;",
                 PARAM(oatpp::Object<AddressDto>, address));
@@ -257,6 +432,23 @@ namespace primus
                 PARAM(oatpp::UInt32, member_id),
                 PARAM(oatpp::String, date));
 
+            /**
+            * First date of the window ranked by the leaderboard, see LeaderboardManager
+            */
+            QUERY(getLeaderboardWindowStart,
+                "SELECT date('now', '-6 months') as date;");
+
+            /**
+            * All attendances, see AttendanceIndex
+            */
+            QUERY(getAllAttendances,
+                "SELECT member_id as memberId, date FROM Attendance;");
+
+            QUERY(getAttendancesSince,
+                " SELECT member_id as memberId, date FROM Attendance "
+                " WHERE date >= :since;",
+                PARAM(oatpp::String, since));
+
             QUERY(getAttendancesOfMember,
                 " SELECT date FROM Attendance "
                 " WHERE member_id = :member_id "
@@ -266,11 +458,40 @@ namespace primus
                 PARAM(oatpp::UInt32, limit),
                 PARAM(oatpp::UInt32, offset));
 
+            /**
+            * Keyset variant of getAttendancesOfMember. Returns the attendances older than the given date
+            *
+            * @param member_id The member id
+            * @param beforeDate Date of the last attendance of the previous page
+            * @param limit Maximum count of attendances
+            *
+            */
+            QUERY(getAttendancesOfMemberBefore,
+                " SELECT date FROM Attendance "
+                " WHERE member_id = :member_id AND date < :beforeDate "
+                " ORDER BY date DESC "
+                " LIMIT :limit;",
+                PARAM(oatpp::UInt32, member_id),
+                PARAM(oatpp::String, beforeDate),
+                PARAM(oatpp::UInt32, limit));
+
             QUERY(getCountOfAttendancesOfMember,
-                " SELECT COUNT(*) as value FROM Attendance "
-                " WHERE member_id = :member_id ",
+                " SELECT IFNULL((SELECT attendances FROM MemberStats WHERE member_id = :member_id), 0) as value ",
                 PARAM(oatpp::UInt32, member_id));
 
+            /**
+            * Same as getCountOfAttendancesOfMember, running on a cached prepared statement
+            *
+            * @param memberId The member id
+            *
+            */
+            CachedQueryResult countAttendancesOfMember(v_uint32 memberId)
+            {
+                return m_routingExecutor->executeCached("countAttendancesOfMember", "SELECT attendances FROM MemberStats WHERE member_id = ?1;", [memberId](sqlite3_stmt* statement) {
+                    return sqlite3_bind_int64(statement, 1, memberId);
+                    });
+            }
+
             QUERY(getMembersByAttendanceDate,
                 " SELECT member_id as value FROM Attendance "
                 " WHERE date = :date "
@@ -320,6 +541,33 @@ namespace primus
                 " WHERE date >= DATE('now', '-1 year') "
                 " AND member_id = :memberId; ",
                 PARAM(oatpp::UInt32, memberId));
+
+            //   __           
+            //  / _| ___  ___ 
+            // | |_ / _ \/ _ \
+            // |  _|  __/  __/
+            // |_|  \___|\___|
+
+            /**
+            * Keyset page of the active members with their departments grouped, see FeeManager.
+            * departmentId and department are only meaningful for members in exactly one department
+            *
+            * @param afterId Only members with a greater id are returned. 0 to start with the first member
+            * @param limit Maximum count of members
+            *
+            */
+            QUERY(getActiveMemberFeesAfter,
+                " SELECT m.id as id, m.firstName as firstName, m.lastName as lastName, "
+                " COUNT(dm.department_id) as departments, MIN(dm.department_id) as departmentId, MIN(d.name) as department "
+                " FROM Member m "
+                " LEFT JOIN Department_Member dm ON dm.member_id = m.id "
+                " LEFT JOIN Department d ON d.id = dm.department_id "
+                " WHERE m.active = 1 AND m.id > :afterId "
+                " GROUP BY m.id "
+                " ORDER BY m.id "
+                " LIMIT :limit;",
+                PARAM(oatpp::UInt32, afterId),
+                PARAM(oatpp::UInt32, limit));
         };
 
 #include OATPP_CODEGEN_END(DbClient) ///< End code-gen section
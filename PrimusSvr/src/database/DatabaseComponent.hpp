@@ -1,9 +1,14 @@
 #ifndef CRUD_DATABASECOMPONENT_HPP
 #define CRUD_DATABASECOMPONENT_HPP
 
+#include <thread>
+
 #include "oatpp/core/macro/component.hpp"
 
 #include "DatabaseClient.hpp"
+#include "SqliteConnectionProvider.hpp"
+#include "RoutingExecutor.hpp"
+#include "WalCheckpointer.hpp"
 #include "filesystemHelper.hpp"
 
 namespace primus
@@ -21,33 +26,72 @@ namespace primus
          */
         class DatabaseComponent {
         public:
-            // Create database connection provider component
+            // Create cache component holding the prepared statements of the hot point lookups
+            OATPP_CREATE_COMPONENT(std::shared_ptr<StatementCache>, statementCache)([] {
+                return std::make_shared<StatementCache>();
+                }());
+
+            // Create provider component which opens and configures the database connections
+            OATPP_CREATE_COMPONENT(std::shared_ptr<SqliteConnectionProvider>, sqliteConnectionProvider)([] {
+                return std::make_shared<SqliteConnectionProvider>(DATABASE_FILE, SqliteSettings::fromEnvironment());
+                }());
+
+            // Create database connection provider component for writing. A single writer, so writes queue up in the pool
             OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::provider::Provider<oatpp::sqlite::Connection>>, dbConnectionProvider)([] {
 
-                /* Create database-specific ConnectionProvider */
-                auto connectionProvider = std::make_shared<oatpp::sqlite::ConnectionProvider>(DATABASE_FILE);
+                /* Get database-specific ConnectionProvider component */
+                OATPP_COMPONENT(std::shared_ptr<SqliteConnectionProvider>, connectionProvider);
 
                 /* Create database-specific ConnectionPool */
                 return oatpp::sqlite::ConnectionPool::createShared(connectionProvider,
-                    10 /* max-connections */,
-                    std::chrono::seconds(5) /* connection TTL */);
+                    primus::constants::database::writeConnections /* max-connections */,
+                    std::chrono::seconds(primus::constants::database::connectionTTL) /* connection TTL */);
+
+                }());
+
+            // Create database connection provider component for reading. One connection per core
+            OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::provider::Provider<oatpp::sqlite::Connection>>, dbReadConnectionProvider)(primus::constants::database::readPoolQualifier, [] {
+
+                /* Get database-specific ConnectionProvider and StatementCache components */
+                OATPP_COMPONENT(std::shared_ptr<SqliteConnectionProvider>, connectionProvider);
+                OATPP_COMPONENT(std::shared_ptr<StatementCache>, statementCache);
+
+                /* Create read-only ConnectionProvider with the same settings */
+                auto readConnectionProvider = std::make_shared<SqliteConnectionProvider>(DATABASE_FILE, connectionProvider->getSettings(), true, statementCache);
+
+                const unsigned int cores = std::thread::hardware_concurrency();
+                const unsigned int maxConnections = cores > primus::constants::database::minReadConnections ? cores : primus::constants::database::minReadConnections;
+
+                /* Create database-specific ConnectionPool */
+                return oatpp::sqlite::ConnectionPool::createShared(readConnectionProvider,
+                    maxConnections /* max-connections */,
+                    std::chrono::seconds(primus::constants::database::connectionTTL) /* connection TTL */);
 
                 }());
 
             // Create database client
             OATPP_CREATE_COMPONENT(std::shared_ptr<DatabaseClient>, database)([] {
 
-                /* Get database ConnectionProvider component */
+                /* Get database ConnectionProvider components */
                 OATPP_COMPONENT(std::shared_ptr<oatpp::provider::Provider<oatpp::sqlite::Connection>>, connectionProvider);
+                OATPP_COMPONENT(std::shared_ptr<oatpp::provider::Provider<oatpp::sqlite::Connection>>, readConnectionProvider, primus::constants::database::readPoolQualifier);
+                OATPP_COMPONENT(std::shared_ptr<StatementCache>, statementCache);
 
-                /* Create database-specific Executor */
-                auto executor = std::make_shared<oatpp::sqlite::Executor>(connectionProvider);
+                /* Create database-specific Executor, routing queries by whether they modify the database */
+                auto executor = std::make_shared<RoutingExecutor>(connectionProvider, readConnectionProvider, statementCache);
 
                 /* Create MyClient database client */
                 return std::make_shared<DatabaseClient>(executor);
 
                 }());
 
+            // Create component which checkpoints the write-ahead log and reports the statement cache in the background
+            OATPP_CREATE_COMPONENT(std::shared_ptr<WalCheckpointer>, walCheckpointer)([] {
+                OATPP_COMPONENT(std::shared_ptr<SqliteConnectionProvider>, connectionProvider);
+                OATPP_COMPONENT(std::shared_ptr<StatementCache>, statementCache);
+                return WalCheckpointer::createShared(connectionProvider, statementCache);
+                }());
+
         };
 
     } //namespace component
@@ -0,0 +1,147 @@
+#ifndef PRIMUS_ROUTINGEXECUTOR_HPP
+#define PRIMUS_ROUTINGEXECUTOR_HPP
+
+#include <memory>
+#include <cctype>
+#include <functional>
+#include <unordered_set>
+#include <unordered_map>
+
+#include "oatpp-sqlite/orm.hpp"
+#include "oatpp/orm/Transaction.hpp"
+
+#include "StatementCache.hpp"
+
+namespace primus
+{
+    namespace component
+    {
+        //  ____             _   _             _____                     _             
+        // |  _ \ ___  _   _| |_(_)_ __   __ _| ____|_  _____  ___ _   _| |_ ___  _ __ 
+        // | |_) / _ \| | | | __| | '_ \ / _` |  _| \ \/ / _ \/ __| | | | __/ _ \| '__|
+        // |  _ < (_) | |_| | |_| | | | | (_| | |___ >  <  __/ (__| |_| | || (_) | |   
+        // |_| \_\___/ \__,_|\__|_|_| |_|\__, |_____/_/\_\___|\___|\__,_|\__\___/|_|   
+        //                               |___/                                         
+        /**
+         * @brief Executor sending plain SELECT queries to a pool of read-only connections and everything else to the read-write pool.
+         * Queries are classified once when the DatabaseClient parses its query templates.
+         * Queries executed on an explicitly passed connection, e.g. inside a transaction, stay on that connection.
+         * Transactions only reading run on the read-only pool, see beginReadTransaction.
+         * Hot point lookups can bypass the query templates and run on statements cached per connection, see executeCached.
+         */
+        class RoutingExecutor : public oatpp::sqlite::Executor
+        {
+            typedef oatpp::provider::Provider<oatpp::sqlite::Connection> ConnectionProvider;
+
+        private:
+            std::shared_ptr<oatpp::sqlite::Executor>    m_readExecutor;
+            std::shared_ptr<StatementCache>             m_statementCache;
+            std::unordered_set<const void*>             m_readQueries; // Extra data of the read-only query templates. Filled before the first query runs
+
+        public:
+            /**
+             * Constructor to initialize the RoutingExecutor.
+             * @param writeConnectionProvider - pool of read-write connections. Also used for migrations and transactions.
+             * @param readConnectionProvider - pool of read-only connections.
+             * @param statementCache - cache the read-only connections evict their statements from when they are closed.
+             */
+            RoutingExecutor(const std::shared_ptr<ConnectionProvider>& writeConnectionProvider, const std::shared_ptr<ConnectionProvider>& readConnectionProvider,
+                const std::shared_ptr<StatementCache>& statementCache)
+                : oatpp::sqlite::Executor(writeConnectionProvider)
+                , m_readExecutor(std::make_shared<oatpp::sqlite::Executor>(readConnectionProvider))
+                , m_statementCache(statementCache)
+            {}
+
+            StringTemplate parseQueryTemplate(const oatpp::String& name, const oatpp::String& text, const ParamsTypeMap& paramsTypeMap, bool prepare) override
+            {
+                auto queryTemplate = oatpp::sqlite::Executor::parseQueryTemplate(name, text, paramsTypeMap, prepare);
+
+                // The extra data is shared by all copies of the template, so its address identifies the query
+                if (isReadQuery(text))
+                    m_readQueries.insert(queryTemplate.getExtraData().get());
+
+                return queryTemplate;
+            }
+
+            std::shared_ptr<oatpp::orm::QueryResult> execute(const StringTemplate& queryTemplate,
+                const std::unordered_map<oatpp::String, oatpp::Void>& params,
+                const std::shared_ptr<const oatpp::data::mapping::TypeResolver>& typeResolver,
+                const oatpp::provider::ResourceHandle<oatpp::orm::Connection>& connection) override
+            {
+                if (connection == nullptr && m_readQueries.count(queryTemplate.getExtraData().get()) != 0)
+                    return oatpp::sqlite::Executor::execute(queryTemplate, params, typeResolver, m_readExecutor->getConnection());
+
+                return oatpp::sqlite::Executor::execute(queryTemplate, params, typeResolver, connection);
+            }
+
+            /**
+             * Begins a transaction on a read-only connection. All queries passed its connection read the same snapshot of the database.
+             * There is nothing to commit, the transaction ends when it is destroyed.
+             * @return The transaction.
+             */
+            oatpp::orm::Transaction beginReadTransaction()
+            {
+                return oatpp::orm::Transaction(m_readExecutor);
+            }
+
+            /**
+             * Runs a read query returning a single integer on a read-only connection, reusing the prepared statement of earlier calls.
+             * @param queryId - unique id of the query, e.g. the name of the DatabaseClient method.
+             * @param sql - text of the query with positional parameters.
+             * @param bind - binds the parameters to the statement. Returns SQLITE_OK on success.
+             * @return Result of the query.
+             */
+            CachedQueryResult executeCached(const std::string& queryId, const char* sql, const std::function<int(sqlite3_stmt*)>& bind)
+            {
+                CachedQueryResult result;
+
+                // Declared before the lease, so the statement is reset before the connection goes back to the pool
+                auto connection = m_readExecutor->getConnection();
+                sqlite3* handle = std::static_pointer_cast<oatpp::sqlite::Connection>(connection.object)->getHandle();
+
+                StatementCache::Lease statement = m_statementCache->acquire(handle, queryId, sql);
+                if (!statement || bind(statement.get()) != SQLITE_OK)
+                {
+                    result.errorMessage = sqlite3_errmsg(handle);
+                    return result;
+                }
+
+                const int step = sqlite3_step(statement.get());
+                if (step == SQLITE_ROW)
+                    result.value = sqlite3_column_int64(statement.get(), 0);
+                else if (step != SQLITE_DONE)
+                {
+                    result.errorMessage = sqlite3_errmsg(handle);
+                    return result;
+                }
+
+                result.success = true;
+                return result;
+            }
+
+        private:
+            static bool isReadQuery(const oatpp::String& text)
+            {
+                static const char keyword[] = "SELECT";
+
+                if (!text)
+                    return false;
+
+                std::size_t pos = 0;
+                while (pos < text->size() && std::isspace(static_cast<unsigned char>((*text)[pos])))
+                    ++pos;
+
+                for (std::size_t i = 0; i < sizeof(keyword) - 1; ++i, ++pos)
+                {
+                    if (pos >= text->size() || std::toupper(static_cast<unsigned char>((*text)[pos])) != keyword[i])
+                        return false;
+                }
+
+                return pos < text->size() && !std::isalnum(static_cast<unsigned char>((*text)[pos]));
+            }
+        };
+
+    } // namespace component
+} // namespace primus
+
+#endif // PRIMUS_ROUTINGEXECUTOR_HPP
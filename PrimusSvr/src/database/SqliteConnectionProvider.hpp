@@ -0,0 +1,225 @@
+#ifndef PRIMUS_SQLITECONNECTIONPROVIDER_HPP
+#define PRIMUS_SQLITECONNECTIONPROVIDER_HPP
+
+#include <string>
+#include <memory>
+#include <cctype>
+
+#include "oatpp-sqlite/orm.hpp"
+
+#include "general/constants.hpp"
+#include "general/environment.hpp"
+#include "StatementCache.hpp"
+
+namespace primus
+{
+    namespace component
+    {
+        /**
+         * @brief Settings applied to every connection to the database.
+         */
+        struct SqliteSettings
+        {
+            std::string journalMode;        /**< Value of PRAGMA journal_mode. */
+            std::string synchronous;        /**< Value of PRAGMA synchronous. */
+            std::string tempStore;          /**< Value of PRAGMA temp_store. */
+            long long   mmapSize;           /**< Value of PRAGMA mmap_size in bytes. */
+            long long   cacheSize;          /**< Size of the page cache in KiB. */
+            long long   busyTimeout;        /**< Value of PRAGMA busy_timeout in milliseconds. */
+            long long   checkpointInterval; /**< Seconds between two WAL checkpoints, 0 disables them. */
+
+            /**
+             * @brief Reads the settings from the environment. Unset variables keep their defaults from the constants.
+             * Variables: PRIMUS_SQLITE_JOURNAL_MODE, PRIMUS_SQLITE_SYNCHRONOUS, PRIMUS_SQLITE_TEMP_STORE, PRIMUS_SQLITE_MMAP_SIZE,
+             * PRIMUS_SQLITE_CACHE_SIZE, PRIMUS_SQLITE_BUSY_TIMEOUT and PRIMUS_SQLITE_CHECKPOINT_INTERVAL.
+             * @return The settings.
+             */
+            static SqliteSettings fromEnvironment(void)
+            {
+                namespace defaults = primus::constants::database;
+
+                SqliteSettings settings;
+                settings.journalMode        = primus::environment::getString("PRIMUS_SQLITE_JOURNAL_MODE", defaults::journalMode);
+                settings.synchronous        = primus::environment::getString("PRIMUS_SQLITE_SYNCHRONOUS", defaults::synchronous);
+                settings.tempStore          = primus::environment::getString("PRIMUS_SQLITE_TEMP_STORE", defaults::tempStore);
+                settings.mmapSize           = primus::environment::getInteger("PRIMUS_SQLITE_MMAP_SIZE", defaults::mmapSize);
+                settings.cacheSize          = primus::environment::getInteger("PRIMUS_SQLITE_CACHE_SIZE", defaults::cacheSize);
+                settings.busyTimeout        = primus::environment::getInteger("PRIMUS_SQLITE_BUSY_TIMEOUT", defaults::busyTimeout);
+                settings.checkpointInterval = primus::environment::getInteger("PRIMUS_SQLITE_CHECKPOINT_INTERVAL", defaults::checkpointInterval);
+
+                // The keywords end up in the pragma statements, anything else than a plain word falls back to the default
+                if (!isKeyword(settings.journalMode))
+                    settings.journalMode = defaults::journalMode;
+                if (!isKeyword(settings.synchronous))
+                    settings.synchronous = defaults::synchronous;
+                if (!isKeyword(settings.tempStore))
+                    settings.tempStore = defaults::tempStore;
+
+                for (auto& c : settings.journalMode)
+                    c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+
+                return settings;
+            }
+
+            /**
+             * @brief Checks whether the connections run in WAL mode.
+             */
+            bool isWal(void) const
+            {
+                return journalMode == "WAL";
+            }
+
+        private:
+            static bool isKeyword(const std::string& value)
+            {
+                for (char c : value)
+                {
+                    if (!std::isalnum(static_cast<unsigned char>(c)))
+                        return false;
+                }
+                return !value.empty();
+            }
+        };
+
+        //  ____        _ _ _        ____                            _   _             ____                 _     _           
+        // / ___|  __ _| (_) |_ ___ / ___|___  _ __  _ __   ___  ___| |_(_) ___  _ __ |  _ \ _ __ _____   _(_) __| | ___ _ __ 
+        // \___ \ / _` | | | __/ _ \ |   / _ \| '_ \| '_ \ / _ \/ __| __| |/ _ \| '_ \| |_) | '__/ _ \ \ / / |/ _` |/ _ \ '__|
+        //  ___) | (_| | | | ||  __/ |__| (_) | | | | | | |  __/ (__| |_| | (_) | | | |  __/| | | (_) \ V /| | (_| |  __/ |   
+        // |____/ \__, |_|_|\__\___|\____\___/|_| |_|_| |_|\___|\___|\__|_|\___/|_| |_|_|   |_|  \___/ \_/ |_|\__,_|\___|_|   
+        //           |_|                                                                                                      
+        /**
+         * @brief Connection provider applying the SqliteSettings to every connection it opens.
+         * Handed to the connection pools, so pooled connections are configured once when they are created.
+         * Read-only connections refuse any statement modifying the database and leave the journal mode as it is.
+         */
+        class SqliteConnectionProvider : public oatpp::sqlite::ConnectionProvider
+        {
+            static constexpr const char* logName = primus::constants::database::logName;
+
+            /**
+             * @brief Drops the cached statements of a connection before it gets closed.
+             */
+            class Invalidator : public oatpp::provider::Invalidator<oatpp::sqlite::Connection>
+            {
+            private:
+                std::shared_ptr<oatpp::provider::Invalidator<oatpp::sqlite::Connection>>   m_invalidator;
+                std::shared_ptr<StatementCache>                                             m_statementCache;
+
+            public:
+                Invalidator(const std::shared_ptr<oatpp::provider::Invalidator<oatpp::sqlite::Connection>>& invalidator, const std::shared_ptr<StatementCache>& statementCache)
+                    : m_invalidator(invalidator)
+                    , m_statementCache(statementCache)
+                {}
+
+                void invalidate(const std::shared_ptr<oatpp::sqlite::Connection>& connection) override
+                {
+                    m_statementCache->evict(connection->getHandle());
+                    m_invalidator->invalidate(connection);
+                }
+            };
+
+        private:
+            SqliteSettings                  m_settings;
+            bool                            m_readOnly;
+            std::shared_ptr<StatementCache> m_statementCache;
+
+        public:
+            /**
+             * Constructor to initialize the SqliteConnectionProvider.
+             * @param databaseFile - path of the database file.
+             * @param settings - settings applied to every connection.
+             * @param readOnly - whether the connections are restricted to reading.
+             * @param statementCache - cache holding prepared statements of the connections. Optional.
+             */
+            SqliteConnectionProvider(const oatpp::String& databaseFile, const SqliteSettings& settings, bool readOnly = false,
+                const std::shared_ptr<StatementCache>& statementCache = nullptr)
+                : oatpp::sqlite::ConnectionProvider(databaseFile)
+                , m_settings(settings)
+                , m_readOnly(readOnly)
+                , m_statementCache(statementCache)
+            {
+                OATPP_LOGI(logName, "%s connections: journal_mode=%s synchronous=%s temp_store=%s mmap_size=%lld cache_size=%lldKiB busy_timeout=%lldms",
+                    m_readOnly ? "Read-only" : "Read-write", m_settings.journalMode.c_str(), m_settings.synchronous.c_str(), m_settings.tempStore.c_str(),
+                    m_settings.mmapSize, m_settings.cacheSize, m_settings.busyTimeout);
+            }
+
+            /**
+             * Opens and configures a new connection.
+             * @return Handle of the connection.
+             */
+            oatpp::provider::ResourceHandle<oatpp::sqlite::Connection> get() override
+            {
+                auto connection = oatpp::sqlite::ConnectionProvider::get();
+                configure(connection.object->getHandle());
+
+                if (m_statementCache)
+                    connection.invalidator = std::make_shared<Invalidator>(connection.invalidator, m_statementCache);
+
+                return connection;
+            }
+
+            /**
+             * Settings applied to the connections.
+             */
+            const SqliteSettings& getSettings(void) const
+            {
+                return m_settings;
+            }
+
+            /**
+             * Cache holding prepared statements of the connections. May be nullptr.
+             */
+            const std::shared_ptr<StatementCache>& getStatementCache(void) const
+            {
+                return m_statementCache;
+            }
+
+        private:
+            void configure(sqlite3* handle)
+            {
+                // Set first, so switching the journal mode waits for other connections instead of failing
+                execute(handle, "PRAGMA busy_timeout=" + std::to_string(m_settings.busyTimeout) + ";");
+
+                // The journal mode is stored in the database file, the read-write connections take care of it
+                if (!m_readOnly)
+                {
+                    std::string journalMode;
+                    execute(handle, "PRAGMA journal_mode=" + m_settings.journalMode + ";", &journalMode);
+                    for (auto& c : journalMode)
+                        c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+                    if (journalMode != m_settings.journalMode)
+                        OATPP_LOGW(logName, "Requested journal_mode=%s but the database uses %s", m_settings.journalMode.c_str(), journalMode.c_str());
+                }
+
+                execute(handle, "PRAGMA synchronous=" + m_settings.synchronous + ";");
+                execute(handle, "PRAGMA temp_store=" + m_settings.tempStore + ";");
+                execute(handle, "PRAGMA mmap_size=" + std::to_string(m_settings.mmapSize) + ";");
+
+                // Negative values are interpreted as KiB instead of pages
+                execute(handle, "PRAGMA cache_size=-" + std::to_string(m_settings.cacheSize) + ";");
+
+                if (m_readOnly)
+                    execute(handle, "PRAGMA query_only=1;");
+            }
+
+            static void execute(sqlite3* handle, const std::string& statement, std::string* result = nullptr)
+            {
+                auto callback = [](void* target, int columns, char** values, char**) -> int {
+                    if (target != nullptr && columns > 0 && values[0] != nullptr)
+                        *static_cast<std::string*>(target) = values[0];
+                    return 0;
+                };
+
+                char* error = nullptr;
+                if (sqlite3_exec(handle, statement.c_str(), callback, result, &error) != SQLITE_OK)
+                {
+                    OATPP_LOGW(logName, "%s failed: %s", statement.c_str(), error ? error : sqlite3_errmsg(handle));
+                    sqlite3_free(error);
+                }
+            }
+        };
+
+    } // namespace component
+} // namespace primus
+
+#endif // PRIMUS_SQLITECONNECTIONPROVIDER_HPP
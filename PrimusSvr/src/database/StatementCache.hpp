@@ -0,0 +1,197 @@
+#ifndef PRIMUS_STATEMENTCACHE_HPP
+#define PRIMUS_STATEMENTCACHE_HPP
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "oatpp-sqlite/orm.hpp"
+
+#include "general/constants.hpp"
+
+namespace primus
+{
+    namespace component
+    {
+        /**
+         * @brief Outcome of a query returning a single integer, e.g. a count.
+         */
+        struct CachedQueryResult
+        {
+            bool            success = false;    /**< Whether the query was executed. */
+            oatpp::String   errorMessage;       /**< Error of the database if the query failed. */
+            v_int64         value = 0;          /**< First column of the first row, 0 if there was no row. */
+
+            bool isSuccess(void) const { return success; }
+            const oatpp::String& getErrorMessage(void) const { return errorMessage; }
+        };
+
+        //  ____  _        _                            _    ____           _          
+        // / ___|| |_ __ _| |_ ___ _ __ ___   ___ _ __ | |_ / ___|__ _  ___| |__   ___ 
+        // \___ \| __/ _` | __/ _ \ '_ ` _ \ / _ \ '_ \| __| |   / _` |/ __| '_ \ / _ \
+        //  ___) | || (_| | ||  __/ | | | | |  __/ | | | |_| |__| (_| | (__| | | |  __/
+        // |____/ \__\__,_|\__\___|_| |_| |_|\___|_| |_|\__|\____\__,_|\___|_| |_|\___|
+        /**
+         * @brief Prepared statements kept alive per database connection, keyed by query id.
+         * A pooled connection is only used by one thread at a time, so its statements need no locking of their own.
+         * The statements of a connection are finalized when the pool closes it.
+         */
+        class StatementCache
+        {
+            static constexpr const char* logName = primus::constants::database::logName;
+
+        public:
+            /**
+             * @brief Statement borrowed from the cache. Reset and unbound when the lease ends, so it is ready for the next use.
+             */
+            class Lease
+            {
+            private:
+                sqlite3_stmt* m_statement;
+
+            public:
+                explicit Lease(sqlite3_stmt* statement)
+                    : m_statement(statement)
+                {}
+
+                Lease(Lease&& other)
+                    : m_statement(other.m_statement)
+                {
+                    other.m_statement = nullptr;
+                }
+
+                Lease(const Lease&) = delete;
+                Lease& operator=(const Lease&) = delete;
+
+                ~Lease(void)
+                {
+                    if (m_statement != nullptr)
+                    {
+                        sqlite3_reset(m_statement);
+                        sqlite3_clear_bindings(m_statement);
+                    }
+                }
+
+                sqlite3_stmt* get(void) const
+                {
+                    return m_statement;
+                }
+
+                explicit operator bool(void) const
+                {
+                    return m_statement != nullptr;
+                }
+            };
+
+        private:
+            std::mutex                                                                  m_lock;
+            std::unordered_map<sqlite3*, std::unordered_map<std::string, sqlite3_stmt*>> m_statements;
+            std::atomic<v_uint64>                                                       m_hits;
+            std::atomic<v_uint64>                                                       m_misses;
+
+        public:
+            StatementCache(void)
+                : m_hits(0)
+                , m_misses(0)
+            {}
+
+            StatementCache(const StatementCache&) = delete;
+            StatementCache& operator=(const StatementCache&) = delete;
+
+            /**
+             * Destructor. Finalizes the statements of connections which were never closed through the pool.
+             */
+            ~StatementCache(void)
+            {
+                for (auto& connection : m_statements)
+                {
+                    for (auto& statement : connection.second)
+                        sqlite3_finalize(statement.second);
+                }
+            }
+
+            /**
+             * Borrows the statement of a query, preparing it on first use on this connection.
+             * @param connection - connection the statement belongs to. Must be held exclusively by the caller until the lease ends.
+             * @param queryId - unique id of the query.
+             * @param sql - text of the query.
+             * @return Lease of the statement. Empty if the query could not be prepared, see sqlite3_errmsg of the connection.
+             */
+            Lease acquire(sqlite3* connection, const std::string& queryId, const char* sql)
+            {
+                {
+                    std::lock_guard<std::mutex> guard(m_lock);
+
+                    auto& statements = m_statements[connection];
+                    auto it = statements.find(queryId);
+                    if (it != statements.end())
+                    {
+                        ++m_hits;
+                        return Lease(it->second);
+                    }
+                }
+
+                ++m_misses;
+
+                sqlite3_stmt* statement = nullptr;
+                if (sqlite3_prepare_v3(connection, sql, -1, SQLITE_PREPARE_PERSISTENT, &statement, nullptr) != SQLITE_OK)
+                {
+                    sqlite3_finalize(statement);
+                    return Lease(nullptr);
+                }
+
+                std::lock_guard<std::mutex> guard(m_lock);
+                m_statements[connection][queryId] = statement;
+
+                return Lease(statement);
+            }
+
+            /**
+             * Finalizes all statements of a connection. Has to be called before the connection is closed.
+             * @param connection - the connection.
+             */
+            void evict(sqlite3* connection)
+            {
+                std::unordered_map<std::string, sqlite3_stmt*> statements;
+
+                {
+                    std::lock_guard<std::mutex> guard(m_lock);
+
+                    auto it = m_statements.find(connection);
+                    if (it == m_statements.end())
+                        return;
+
+                    statements.swap(it->second);
+                    m_statements.erase(it);
+                }
+
+                for (auto& statement : statements)
+                    sqlite3_finalize(statement.second);
+
+                OATPP_LOGD(logName, "Finalized %d cached statements of a closed connection. Cache hits=%llu misses=%llu",
+                    static_cast<int>(statements.size()), static_cast<unsigned long long>(getHits()), static_cast<unsigned long long>(getMisses()));
+            }
+
+            /**
+             * Count of queries which found their statement in the cache.
+             */
+            v_uint64 getHits(void) const
+            {
+                return m_hits.load();
+            }
+
+            /**
+             * Count of queries which had to prepare their statement.
+             */
+            v_uint64 getMisses(void) const
+            {
+                return m_misses.load();
+            }
+        };
+
+    } // namespace component
+} // namespace primus
+
+#endif // PRIMUS_STATEMENTCACHE_HPP
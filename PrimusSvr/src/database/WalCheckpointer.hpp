@@ -0,0 +1,151 @@
+#ifndef PRIMUS_WALCHECKPOINTER_HPP
+#define PRIMUS_WALCHECKPOINTER_HPP
+
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <condition_variable>
+
+#include "SqliteConnectionProvider.hpp"
+#include "StatementCache.hpp"
+
+namespace primus
+{
+    namespace component
+    {
+        // __        __    _  ____ _               _                _       _            
+        // \ \      / /_ _| |/ ___| |__   ___  ___| | ___ __   ___ (_)_ __ | |_ ___ _ __ 
+        //  \ \ /\ / / _` | | |   | '_ \ / _ \/ __| |/ / '_ \ / _ \| | '_ \| __/ _ \ '__|
+        //   \ V  V / (_| | | |___| | | |  __/ (__|   <| |_) | (_) | | | | | ||  __/ |   
+        //    \_/\_/ \__,_|_|\____|_| |_|\___|\___|_|\_\ .__/ \___/|_|_| |_|\__\___|_|   
+        //                                             |_|                               
+        /**
+         * @brief Background worker copying the write-ahead log back into the database file at a fixed interval.
+         * Checkpoints are passive, they never wait for readers or writers. Keeps the WAL file from growing
+         * while there is always a reader active, e.g. during busy check-in evenings.
+         * Every tick also logs the hits and misses of the statement cache if they changed, so its effect can be watched in the log.
+         */
+        class WalCheckpointer
+        {
+            static constexpr const char* logName = primus::constants::database::logName;
+
+        private:
+            std::shared_ptr<SqliteConnectionProvider>   m_provider;
+            std::shared_ptr<StatementCache>             m_statementCache;
+            std::chrono::seconds                        m_interval;
+            v_uint64                                    m_loggedHits;
+            v_uint64                                    m_loggedMisses;
+            std::mutex                                  m_lock;
+            std::condition_variable                     m_wakeup;
+            bool                                        m_stop;
+            std::thread                                 m_worker;
+
+        private:
+            WalCheckpointer(const std::shared_ptr<SqliteConnectionProvider>& provider, const std::shared_ptr<StatementCache>& statementCache)
+                : m_provider(provider)
+                , m_statementCache(statementCache)
+                , m_interval(provider->getSettings().checkpointInterval)
+                , m_loggedHits(0)
+                , m_loggedMisses(0)
+                , m_stop(false)
+            {
+                if ((provider->getSettings().isWal() || m_statementCache) && m_interval.count() > 0)
+                    m_worker = std::thread(&WalCheckpointer::run, this);
+            }
+
+        public:
+            WalCheckpointer(const WalCheckpointer&) = delete;
+            WalCheckpointer& operator=(const WalCheckpointer&) = delete;
+
+            /**
+             * Destructor. Stops the background worker.
+             */
+            ~WalCheckpointer(void)
+            {
+                {
+                    std::lock_guard<std::mutex> guard(m_lock);
+                    m_stop = true;
+                }
+
+                m_wakeup.notify_all();
+                if (m_worker.joinable())
+                    m_worker.join();
+            }
+
+            /**
+             * Creates the checkpointer. No worker is started if the interval is 0, or if the connections do not use WAL mode and there is no statement cache.
+             * @param provider - provider of the connections. Checkpoints use a connection of their own, not one of the pool.
+             * @param statementCache - cache whose counters are logged every tick. May be nullptr.
+             * @return Shared pointer to the checkpointer.
+             */
+            static std::shared_ptr<WalCheckpointer> createShared(const std::shared_ptr<SqliteConnectionProvider>& provider,
+                const std::shared_ptr<StatementCache>& statementCache = nullptr)
+            {
+                return std::shared_ptr<WalCheckpointer>(new WalCheckpointer(provider, statementCache));
+            }
+
+        private:
+            void run(void)
+            {
+                std::unique_lock<std::mutex> lock(m_lock);
+
+                while (!m_wakeup.wait_for(lock, m_interval, [this] { return m_stop; }))
+                {
+                    lock.unlock();
+                    if (m_provider->getSettings().isWal())
+                        checkpoint();
+                    logStatementCache();
+                    lock.lock();
+                }
+            }
+
+            void checkpoint(void)
+            {
+                try
+                {
+                    auto connection = m_provider->get();
+
+                    int logFrames = 0;
+                    int checkpointedFrames = 0;
+                    const int result = sqlite3_wal_checkpoint_v2(connection.object->getHandle(), nullptr, SQLITE_CHECKPOINT_PASSIVE, &logFrames, &checkpointedFrames);
+
+                    if (result != SQLITE_OK)
+                        OATPP_LOGW(logName, "WAL checkpoint failed: %s", sqlite3_errmsg(connection.object->getHandle()));
+                    else if (logFrames > 0)
+                        OATPP_LOGD(logName, "WAL checkpoint copied %d of %d frames", checkpointedFrames, logFrames);
+
+                    connection.invalidator->invalidate(connection.object);
+                }
+                catch (const std::exception& e)
+                {
+                    OATPP_LOGW(logName, "WAL checkpoint skipped: %s", e.what());
+                }
+            }
+
+            void logStatementCache(void)
+            {
+                if (!m_statementCache)
+                    return;
+
+                const v_uint64 hits = m_statementCache->getHits();
+                const v_uint64 misses = m_statementCache->getMisses();
+
+                // An idle server does not repeat the same line
+                if (hits == m_loggedHits && misses == m_loggedMisses)
+                    return;
+
+                OATPP_LOGI(logName, "Statement cache: %llu hits, %llu misses (%llu hits and %llu misses since the last report)",
+                    static_cast<unsigned long long>(hits), static_cast<unsigned long long>(misses),
+                    static_cast<unsigned long long>(hits - m_loggedHits), static_cast<unsigned long long>(misses - m_loggedMisses));
+
+                m_loggedHits = hits;
+                m_loggedMisses = misses;
+            }
+        };
+
+    } // namespace component
+} // namespace primus
+
+#endif // PRIMUS_WALCHECKPOINTER_HPP
@@ -56,6 +56,41 @@ namespace primus
             };
 
 
+            //     _   _   _                 _                      ____  _        
+            //    / \ | |_| |_ ___ _ __   __| | __ _ _ __   ___ ___|  _ \| |_ ___  
+            //   / _ \| __| __/ _ \ '_ \ / _` |/ _` | '_ \ / __/ _ \ | | | __/ _ \ 
+            //  / ___ \ |_| ||  __/ | | | (_| | (_| | | | | (_|  __/ |_| | || (_) |
+            // /_/   \_\__|\__\___|_| |_|\__,_|\__,_|_| |_|\___\___|____/ \__\___/
+            /**
+             * @brief DTO class representing the attendance of a member on a date.
+             */
+            class AttendanceDto : public oatpp::DTO
+            {
+
+                DTO_INIT(AttendanceDto, DTO)
+
+                DTO_FIELD(oatpp::UInt32, memberId);
+                DTO_FIELD(oatpp::String, date);
+            };
+
+            //  ____  _      _   _         _             ____  _        
+            // | __ )(_)_ __| |_| |__   __| | __ _ _   _|  _ \| |_ ___  
+            // |  _ \| | '__| __| '_ \ / _` |/ _` | | | | | | | __/ _ \ 
+            // | |_) | | |  | |_| | | | (_| | (_| | |_| | |_| | || (_) |
+            // |____/|_|_|   \__|_| |_|\__,_|\__,_|\__, |____/ \__\___/ 
+            //                                     |___/                
+            /**
+             * @brief DTO class representing the day of the birthday (MM-DD) of a member.
+             */
+            class BirthdayDto : public oatpp::DTO
+            {
+
+                DTO_INIT(BirthdayDto, DTO)
+
+                DTO_FIELD(oatpp::UInt32, memberId);
+                DTO_FIELD(oatpp::String, day);
+            };
+
             //  ____        _       ____  _        
             // |  _ \  __ _| |_ ___|  _ \| |_ ___  
             // | | | |/ _` | __/ _ \ | | | __/ _ \ 
@@ -159,6 +194,24 @@ namespace primus
                     info->description = "Whether or not the member is activated";
                 }
             };
+
+            //  ____             __ _ _       ____                  _       ____  _        
+            // |  _ \ _ __ ___  / _(_) | ___ / ___|___  _   _ _ __ | |_ ___|  _ \| |_ ___  
+            // | |_) | '__/ _ \| |_| | |/ _ \ |   / _ \| | | | '_ \| __/ __| | | | __/ _ \ 
+            // |  __/| | | (_) |  _| | |  __/ |__| (_) | |_| | | | | |_\__ \ |_| | || (_) |
+            // |_|   |_|  \___/|_| |_|_|\___|\____\___/ \__,_|_| |_|\__|___/____/ \__\___/ 
+            /**
+             * @brief DTO class representing the totals of the lists of a member, read at once for the profile.
+             */
+            class ProfileCountsDto : public oatpp::DTO
+            {
+
+                DTO_INIT(ProfileCountsDto, DTO)
+
+                DTO_FIELD(oatpp::UInt32, addresses);
+                DTO_FIELD(oatpp::UInt32, departments);
+                DTO_FIELD(oatpp::UInt32, attendances);
+            };
 #include OATPP_CODEGEN_END(DTO)
         } // namespace database
     } // namespace dto
@@ -0,0 +1,64 @@
+#ifndef ELIGIBILITYDTO_HPP
+#define ELIGIBILITYDTO_HPP
+
+#include "oatpp/core/Types.hpp"
+#include "oatpp/core/macro/codegen.hpp"
+
+namespace primus
+{
+    namespace dto
+    {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+        //  _____ _ _       _ _     _ _ _ _         ____  _        
+        // | ____| (_) __ _(_) |__ (_) (_) |_ _   _|  _ \| |_ ___  
+        // |  _| | | |/ _` | | '_ \| | | | __| | | | | | | __/ _ \ 
+        // | |___| | | (_| | | |_) | | | | |_| |_| | |_| | || (_) |
+        // |_____|_|_|\__, |_|_.__/|_|_|_|\__|\__, |____/ \__\___/ 
+        //            |___/                   |___/                
+        /**
+        * @brief DTO class representing whether a member may purchase a firearm, together with the attendances it is based on.
+        */
+        class EligibilityDto : public oatpp::DTO
+        {
+
+            DTO_INIT(EligibilityDto, DTO);
+
+            DTO_FIELD_INFO(id) {
+                info->description = "Unique identifier of the member";
+            }
+            DTO_FIELD(oatpp::UInt32, id);
+
+            DTO_FIELD_INFO(firstName) {
+                info->description = "First name of the member";
+            }
+            DTO_FIELD(oatpp::String, firstName);
+
+            DTO_FIELD_INFO(lastName) {
+                info->description = "Last name of the member";
+            }
+            DTO_FIELD(oatpp::String, lastName);
+
+            DTO_FIELD_INFO(attendances) {
+                info->description = "Count of attendances within the last year";
+            }
+            DTO_FIELD(oatpp::UInt32, attendances);
+
+            DTO_FIELD_INFO(months) {
+                info->description = "Count of distinct months with an attendance within the last year";
+            }
+            DTO_FIELD(oatpp::UInt32, months);
+
+            DTO_FIELD_INFO(eligible) {
+                info->description = "Whether or not the member is allowed to purchase a firearm";
+            }
+            DTO_FIELD(oatpp::Boolean, eligible);
+
+        };
+
+#include OATPP_CODEGEN_END(DTO)
+
+    } // namespace dto
+} // namespace primus
+
+#endif // ELIGIBILITYDTO_HPP
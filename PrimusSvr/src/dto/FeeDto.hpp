@@ -0,0 +1,160 @@
+#ifndef FEEDTO_HPP
+#define FEEDTO_HPP
+
+#include "oatpp/core/Types.hpp"
+#include "oatpp/core/macro/codegen.hpp"
+
+namespace primus
+{
+    namespace dto
+    {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+        //  __  __                _               _____         ____  _        
+        // |  \/  | ___ _ __ ___ | |__   ___ _ __|  ___|__  ___|  _ \| |_ ___  
+        // | |\/| |/ _ \ '_ ` _ \| '_ \ / _ \ '__| |_ / _ \/ _ \ | | | __/ _ \ 
+        // | |  | |  __/ | | | | | |_) |  __/ |  |  _|  __/  __/ |_| | || (_) |
+        // |_|  |_|\___|_| |_| |_|_.__/ \___|_|  |_|  \___|\___|____/ \__\___/ 
+        /**
+        * @brief DTO class representing the membership fee of a member.
+        * The fields up to department are read by the grouped fee query, see FeeManager.
+        */
+        class MemberFeeDto : public oatpp::DTO
+        {
+
+            DTO_INIT(MemberFeeDto, DTO);
+
+            DTO_FIELD_INFO(id) {
+                info->description = "Unique identifier of the member";
+            }
+            DTO_FIELD(oatpp::UInt32, id);
+
+            DTO_FIELD_INFO(firstName) {
+                info->description = "First name of the member";
+            }
+            DTO_FIELD(oatpp::String, firstName);
+
+            DTO_FIELD_INFO(lastName) {
+                info->description = "Last name of the member";
+            }
+            DTO_FIELD(oatpp::String, lastName);
+
+            DTO_FIELD_INFO(departments) {
+                info->description = "Count of departments of the member";
+            }
+            DTO_FIELD(oatpp::UInt32, departments);
+
+            DTO_FIELD_INFO(departmentId) {
+                info->description = "Identifier of the department. Null unless the member is in exactly one department";
+            }
+            DTO_FIELD(oatpp::UInt32, departmentId);
+
+            DTO_FIELD_INFO(department) {
+                info->description = "Name of the department. Null unless the member is in exactly one department";
+            }
+            DTO_FIELD(oatpp::String, department);
+
+            DTO_FIELD_INFO(fee) {
+                info->description = "Membership fee in euro";
+            }
+            DTO_FIELD(oatpp::UInt32, fee);
+
+        };
+
+        //  _____        _____     _        _ ____  _        
+        // |  ___|__  __|_   _|__ | |_ __ _| |  _ \| |_ ___  
+        // | |_ / _ \/ _ \| |/ _ \| __/ _` | | | | | __/ _ \ 
+        // |  _|  __/  __/| | (_) | || (_| | | |_| | || (_) |
+        // |_|  \___|\___||_|\___/ \__\__,_|_|____/ \__\___/ 
+        /**
+        * @brief DTO class representing the fees of a group of members.
+        */
+        class FeeTotalDto : public oatpp::DTO
+        {
+
+            DTO_INIT(FeeTotalDto, DTO);
+
+            DTO_FIELD_INFO(departmentId) {
+                info->description = "Identifier of the department. Null for the members in several or no departments";
+            }
+            DTO_FIELD(oatpp::UInt32, departmentId);
+
+            DTO_FIELD_INFO(department) {
+                info->description = "Name of the department, Multiple or None";
+            }
+            DTO_FIELD(oatpp::String, department);
+
+            DTO_FIELD_INFO(members) {
+                info->description = "Count of members";
+            }
+            DTO_FIELD(oatpp::UInt32, members);
+
+            DTO_FIELD_INFO(amount) {
+                info->description = "Sum of the fees of the members in euro";
+            }
+            DTO_FIELD(oatpp::UInt32, amount);
+
+        };
+
+        //  _____        _____     _        _     ____  _        
+        // |  ___|__  __|_   _|__ | |_ __ _| |___|  _ \| |_ ___  
+        // | |_ / _ \/ _ \| |/ _ \| __/ _` | / __| | | | __/ _ \ 
+        // |  _|  __/  __/| | (_) | || (_| | \__ \ |_| | || (_) |
+        // |_|  \___|\___||_|\___/ \__\__,_|_|___/____/ \__\___/ 
+        /**
+        * @brief DTO class representing the totals of a fee report.
+        */
+        class FeeTotalsDto : public oatpp::DTO
+        {
+
+            DTO_INIT(FeeTotalsDto, DTO);
+
+            DTO_FIELD_INFO(departments) {
+                info->description = "Totals of the members in exactly one department per department, followed by the members in several and in no department";
+            }
+            DTO_FIELD(oatpp::Vector<oatpp::Object<FeeTotalDto>>, departments);
+
+            DTO_FIELD_INFO(members) {
+                info->description = "Count of all members in the report";
+            }
+            DTO_FIELD(oatpp::UInt32, members);
+
+            DTO_FIELD_INFO(amount) {
+                info->description = "Sum of all fees in euro";
+            }
+            DTO_FIELD(oatpp::UInt32, amount);
+
+        };
+
+        //  _____         ____                       _   ____  _        
+        // |  ___|__  ___|  _ \ ___ _ __   ___  _ __| |_|  _ \| |_ ___  
+        // | |_ / _ \/ _ \ |_) / _ \ '_ \ / _ \| '__| __| | | | __/ _ \ 
+        // |  _|  __/  __/  _ <  __/ |_) | (_) | |  | |_| |_| | || (_) |
+        // |_|  \___|\___|_| \_\___| .__/ \___/|_|   \__|____/ \__\___/ 
+        //                         |_|                                  
+        /**
+        * @brief DTO class representing the fees of all active members. Only used to document the streamed report.
+        */
+        class FeeReportDto : public oatpp::DTO
+        {
+
+            DTO_INIT(FeeReportDto, DTO);
+
+            DTO_FIELD_INFO(members) {
+                info->description = "Fees of the members, sorted by id";
+            }
+            DTO_FIELD(oatpp::Vector<oatpp::Object<MemberFeeDto>>, members);
+
+            DTO_FIELD_INFO(totals) {
+                info->description = "Totals of the report";
+            }
+            DTO_FIELD(oatpp::Object<FeeTotalsDto>, totals);
+
+        };
+
+#include OATPP_CODEGEN_END(DTO)
+
+    } // namespace dto
+} // namespace primus
+
+#endif // FEEDTO_HPP
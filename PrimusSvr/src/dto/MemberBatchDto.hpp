@@ -0,0 +1,97 @@
+#ifndef MEMBERBATCHDTO_HPP
+#define MEMBERBATCHDTO_HPP
+
+#include "oatpp/core/Types.hpp"
+#include "oatpp/core/macro/codegen.hpp"
+#include "DatabaseDtos.hpp"
+
+namespace primus
+{
+    namespace dto
+    {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+        //  __  __                _               ____        _       _     ____                            _   ____  _        
+        // |  \/  | ___ _ __ ___ | |__   ___ _ __| __ )  __ _| |_ ___| |__ |  _ \ ___  __ _ _   _  ___  ___| |_|  _ \| |_ ___  
+        // | |\/| |/ _ \ '_ ` _ \| '_ \ / _ \ '__|  _ \ / _` | __/ __| '_ \| |_) / _ \/ _` | | | |/ _ \/ __| __| | | | __/ _ \ 
+        // | |  | |  __/ | | | | | |_) |  __/ |  | |_) | (_| | || (__| | | |  _ <  __/ (_| | |_| |  __/\__ \ |_| |_| | || (_) |
+        // |_|  |_|\___|_| |_| |_|_.__/ \___|_|  |____/ \__,_|\__\___|_| |_|_| \_\___|\__, |\__,_|\___||___/\__|____/ \__\___/ 
+        //                                                                               |_|                                   
+        /**
+        * @brief DTO class representing a request for several members at once.
+        */
+        class MemberBatchRequestDto : public oatpp::DTO
+        {
+
+            DTO_INIT(MemberBatchRequestDto, DTO);
+
+            DTO_FIELD_INFO(ids) {
+                info->description = "Identifiers of the members";
+                info->required = true;
+            }
+            DTO_FIELD(oatpp::Vector<oatpp::UInt32>, ids);
+
+            DTO_FIELD_INFO(include) {
+                info->description = "Aggregates to add to every member (options: attendances)";
+            }
+            DTO_FIELD(oatpp::Vector<oatpp::String>, include);
+
+        };
+
+        //  __  __                _               ____        _       _     _____       _              ____  _        
+        // |  \/  | ___ _ __ ___ | |__   ___ _ __| __ )  __ _| |_ ___| |__ | ____|_ __ | |_ _ __ _   _|  _ \| |_ ___  
+        // | |\/| |/ _ \ '_ ` _ \| '_ \ / _ \ '__|  _ \ / _` | __/ __| '_ \|  _| | '_ \| __| '__| | | | | | | __/ _ \ 
+        // | |  | |  __/ | | | | | |_) |  __/ |  | |_) | (_| | || (__| | | | |___| | | | |_| |  | |_| | |_| | || (_) |
+        // |_|  |_|\___|_| |_| |_|_.__/ \___|_|  |____/ \__,_|\__\___|_| |_|_____|_| |_|\__|_|   \__, |____/ \__\___/ 
+        //                                                                                       |___/                
+        /**
+        * @brief DTO class representing a member of a batch together with the requested aggregates.
+        */
+        class MemberBatchEntryDto : public oatpp::DTO
+        {
+
+            DTO_INIT(MemberBatchEntryDto, DTO);
+
+            DTO_FIELD_INFO(member) {
+                info->description = "The member";
+            }
+            DTO_FIELD(oatpp::Object<primus::dto::database::MemberDto>, member);
+
+            DTO_FIELD_INFO(attendances) {
+                info->description = "Total count of attendances of the member. Null if not requested";
+            }
+            DTO_FIELD(oatpp::UInt32, attendances);
+
+        };
+
+        //  __  __                _               ____        _       _     ____  _        
+        // |  \/  | ___ _ __ ___ | |__   ___ _ __| __ )  __ _| |_ ___| |__ |  _ \| |_ ___  
+        // | |\/| |/ _ \ '_ ` _ \| '_ \ / _ \ '__|  _ \ / _` | __/ __| '_ \| | | | __/ _ \ 
+        // | |  | |  __/ | | | | | |_) |  __/ |  | |_) | (_| | || (__| | | | |_| | || (_) |
+        // |_|  |_|\___|_| |_| |_|_.__/ \___|_|  |____/ \__,_|\__\___|_| |_|____/ \__\___/ 
+        /**
+        * @brief DTO class representing the members of a batch, keyed by their id.
+        */
+        class MemberBatchDto : public oatpp::DTO
+        {
+
+            DTO_INIT(MemberBatchDto, DTO);
+
+            DTO_FIELD_INFO(members) {
+                info->description = "Members found, keyed by their id";
+            }
+            DTO_FIELD(oatpp::Fields<oatpp::Object<MemberBatchEntryDto>>, members);
+
+            DTO_FIELD_INFO(missing) {
+                info->description = "Requested ids without a member";
+            }
+            DTO_FIELD(oatpp::Vector<oatpp::UInt32>, missing);
+
+        };
+
+#include OATPP_CODEGEN_END(DTO)
+
+    } // namespace dto
+} // namespace primus
+
+#endif // MEMBERBATCHDTO_HPP
@@ -35,10 +35,21 @@ namespace primus
 
             DTO_FIELD(UInt32, count);
             DTO_FIELD_INFO(count) {
-                info->description = "Total count of items";
+                info->description = "Count of items in this page";
                 info->required = true;
             }
 
+            DTO_FIELD(UInt32, total);
+            DTO_FIELD_INFO(total) {
+                info->description = "Total count of items in the list, independent of limit and offset";
+                info->required = true;
+            }
+
+            DTO_FIELD(String, nextCursor);
+            DTO_FIELD_INFO(nextCursor) {
+                info->description = "Token to pass as 'after' to retrieve the next page. Null if the list supports no cursor or there are no more items";
+            }
+
             DTO_FIELD(Vector<T>, items);
             DTO_FIELD_INFO(items) {
                 info->description = "List of items";
@@ -0,0 +1,72 @@
+#ifndef PROFILEDTO_HPP
+#define PROFILEDTO_HPP
+
+#include "oatpp/core/Types.hpp"
+#include "oatpp/core/macro/codegen.hpp"
+#include "DatabaseDtos.hpp"
+#include "PageDto.hpp"
+#include "EligibilityDto.hpp"
+
+namespace primus
+{
+    namespace dto
+    {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+        //  ____             __ _ _      ____  _        
+        // |  _ \ _ __ ___  / _(_) | ___|  _ \| |_ ___  
+        // | |_) | '__/ _ \| |_| | |/ _ \ | | | __/ _ \ 
+        // |  __/| | | (_) |  _| | |  __/ |_| | || (_) |
+        // |_|   |_|  \___/|_| |_|_|\___|____/ \__\___/ 
+        /**
+        * @brief DTO class representing everything shown on the profile of a member.
+        * Sections which were not requested are null.
+        */
+        class ProfileDto : public oatpp::DTO
+        {
+
+            DTO_INIT(ProfileDto, DTO);
+
+            DTO_FIELD_INFO(member) {
+                info->description = "The member";
+            }
+            DTO_FIELD(oatpp::Object<primus::dto::database::MemberDto>, member);
+
+            DTO_FIELD_INFO(addresses) {
+                info->description = "First page of the addresses of the member";
+            }
+            DTO_FIELD(oatpp::Object<AddressPageDto>, addresses);
+
+            DTO_FIELD_INFO(departments) {
+                info->description = "First page of the departments of the member";
+            }
+            DTO_FIELD(oatpp::Object<DepartmentPageDto>, departments);
+
+            DTO_FIELD_INFO(fee) {
+                info->description = "Membership fee in euro, based on the departments";
+            }
+            DTO_FIELD(oatpp::UInt32, fee);
+
+            DTO_FIELD_INFO(weaponPurchase) {
+                info->description = "Whether or not the member is allowed to purchase a firearm";
+            }
+            DTO_FIELD(oatpp::Object<EligibilityDto>, weaponPurchase);
+
+            DTO_FIELD_INFO(attendanceCount) {
+                info->description = "Total count of attendances of the member";
+            }
+            DTO_FIELD(oatpp::UInt32, attendanceCount);
+
+            DTO_FIELD_INFO(attendances) {
+                info->description = "Requested page of the attendances of the member, latest first";
+            }
+            DTO_FIELD(oatpp::Object<DatePageDto>, attendances);
+
+        };
+
+#include OATPP_CODEGEN_END(DTO)
+
+    } // namespace dto
+} // namespace primus
+
+#endif // PROFILEDTO_HPP
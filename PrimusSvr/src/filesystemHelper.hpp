@@ -4,13 +4,20 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <vector>
+#include <ctime>
+#include <cstdio>
+#include <cstdint>
 
 #ifdef _WIN32
 #include <Windows.h>
 #include <direct.h>
-#elif __linux__
+#include <sys/types.h>
+#include <sys/stat.h>
+#else
 #include <sys/stat.h>
 #include <unistd.h>
+#include <dirent.h>
 #endif
 
 namespace primus {
@@ -57,6 +64,133 @@ namespace primus {
             //                 return false;
             //             }
             //         }
+
+            /**
+             * @brief Size and modification time of a file
+             */
+            struct FileInfo
+            {
+                int64_t     size     = 0; /**< Size of the file in bytes. */
+                std::time_t modified = 0; /**< Time of the last modification. */
+            };
+
+            /**
+             * @brief Retrieves size and modification time of a regular file.
+             * @param path Path of the file.
+             * @param info Receives the file information.
+             * @return True if the path exists and is a regular file, false otherwise.
+             */
+            inline bool getFileInfo(const std::string& path, FileInfo& info)
+            {
+#ifdef _WIN32
+                struct _stat64 fileStat;
+                if (_stat64(path.c_str(), &fileStat) != 0 || (fileStat.st_mode & _S_IFREG) == 0)
+                    return false;
+#else
+                struct stat fileStat;
+                if (stat(path.c_str(), &fileStat) != 0 || !S_ISREG(fileStat.st_mode))
+                    return false;
+#endif
+                info.size = static_cast<int64_t>(fileStat.st_size);
+                info.modified = fileStat.st_mtime;
+                return true;
+            }
+
+            /**
+             * @brief Collects the paths of all regular files below a directory.
+             * @param directory Directory to search.
+             * @param prefix Relative path of the directory. Prepended to every collected path.
+             * @param files Receives the collected paths relative to the directory, separated by '/'.
+             */
+            inline void listFilesRecursive(const std::string& directory, const std::string& prefix, std::vector<std::string>& files)
+            {
+#ifdef _WIN32
+                WIN32_FIND_DATAA entry;
+                HANDLE handle = FindFirstFileA((directory + "\\*").c_str(), &entry);
+                if (handle == INVALID_HANDLE_VALUE)
+                    return;
+
+                do
+                {
+                    const std::string name(entry.cFileName);
+                    if (name == "." || name == "..")
+                        continue;
+
+                    if (entry.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+                        listFilesRecursive(directory + "\\" + name, prefix + name + "/", files);
+                    else
+                        files.push_back(prefix + name);
+                } while (FindNextFileA(handle, &entry));
+
+                FindClose(handle);
+#else
+                DIR* dir = opendir(directory.c_str());
+                if (dir == nullptr)
+                    return;
+
+                while (struct dirent* entry = readdir(dir))
+                {
+                    const std::string name(entry->d_name);
+                    if (name == "." || name == "..")
+                        continue;
+
+                    struct stat entryStat;
+                    if (stat((directory + "/" + name).c_str(), &entryStat) != 0)
+                        continue;
+
+                    if (S_ISDIR(entryStat.st_mode))
+                        listFilesRecursive(directory + "/" + name, prefix + name + "/", files);
+                    else if (S_ISREG(entryStat.st_mode))
+                        files.push_back(prefix + name);
+                }
+
+                closedir(dir);
+#endif
+            }
+
+            /**
+             * @brief Opens a file with the C standard library.
+             * @param path Path of the file.
+             * @param mode Mode as for std::fopen, e.g. "rb".
+             * @return Handle of the file or nullptr on failure. Has to be closed with std::fclose.
+             */
+            inline std::FILE* openFile(const std::string& path, const char* mode)
+            {
+                std::FILE* file = nullptr;
+#ifdef _WIN32
+                if (fopen_s(&file, path.c_str(), mode) != 0)
+                    return nullptr;
+#else
+                file = std::fopen(path.c_str(), mode);
+#endif
+                return file;
+            }
+
+            /**
+             * @brief Moves a file to a new path, replacing an existing file at that path.
+             * Readers see either the old or the new file, never a partially written one, as long as both paths are on the same volume.
+             * @param from Path of the file to move.
+             * @param to Destination path.
+             * @return True on success.
+             */
+            inline bool replaceFile(const std::string& from, const std::string& to)
+            {
+#ifdef _WIN32
+                return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+                return std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+            }
+
+            /**
+             * @brief Deletes a file.
+             * @param path Path of the file.
+             * @return True if the file was deleted.
+             */
+            inline bool removeFile(const std::string& path)
+            {
+                return std::remove(path.c_str()) == 0;
+            }
         } // filesystem
     } // namespace component
 } // Namespace primus
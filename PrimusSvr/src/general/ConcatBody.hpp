@@ -0,0 +1,81 @@
+#ifndef PRIMUSCONCATBODY_HPP
+#define PRIMUSCONCATBODY_HPP
+
+#include <memory>
+#include <vector>
+
+#include "oatpp/web/protocol/http/outgoing/Body.hpp"
+
+namespace primus
+{
+    namespace http
+    {
+        /**
+         * @brief Response body sending several bodies one after another, e.g. the parts of a multipart response.
+         * All parts need to know their size in advance.
+         */
+        class ConcatBody : public oatpp::web::protocol::http::outgoing::Body
+        {
+        private:
+            std::vector<std::shared_ptr<Body>>  m_parts;
+            oatpp::String                       m_contentType;
+            std::size_t                         m_current;
+            v_int64                             m_size;
+
+        public:
+            /**
+             * @brief Constructor for the ConcatBody class.
+             * @param contentType Value of the Content-Type header.
+             */
+            explicit ConcatBody(const oatpp::String& contentType)
+                : m_contentType(contentType)
+                , m_current(0)
+                , m_size(0)
+            {}
+
+            /**
+             * @brief Appends a part. Must not be called once sending has started.
+             * @param part Body of the part.
+             */
+            void addPart(const std::shared_ptr<Body>& part)
+            {
+                m_size += part->getKnownSize();
+                m_parts.push_back(part);
+            }
+
+            v_io_size read(void* buffer, v_buff_size count, oatpp::async::Action& action) override
+            {
+                while (m_current < m_parts.size())
+                {
+                    const v_io_size result = m_parts[m_current]->read(buffer, count, action);
+                    if (result != 0)
+                        return result;
+
+                    // Drop finished parts right away, this closes their files early
+                    m_parts[m_current].reset();
+                    ++m_current;
+                }
+
+                return 0;
+            }
+
+            void declareHeaders(Headers& headers) override
+            {
+                if (m_contentType)
+                    headers.putIfNotExists(oatpp::web::protocol::http::Header::CONTENT_TYPE, m_contentType);
+            }
+
+            p_char8 getKnownData(void) override
+            {
+                return nullptr;
+            }
+
+            v_int64 getKnownSize(void) override
+            {
+                return m_size;
+            }
+        };
+    } // Namespace http
+} // Namespace primus
+
+#endif // PRIMUSCONCATBODY_HPP
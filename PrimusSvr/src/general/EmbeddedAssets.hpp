@@ -0,0 +1,50 @@
+#ifndef PRIMUSEMBEDDEDASSETS_HPP
+#define PRIMUSEMBEDDEDASSETS_HPP
+
+#include <cstddef>
+#include <ctime>
+
+namespace primus
+{
+    namespace embedded
+    {
+        /**
+         * @brief Compressed representation of an embedded file.
+         */
+        struct EmbeddedVariant
+        {
+            const char*             encoding;   /**< Value of the Content-Encoding header. */
+            const unsigned char*    data;       /**< Compressed content. */
+            std::size_t             size;       /**< Size of the compressed content in bytes. */
+            const char*             etag;       /**< Entity tag of this representation. */
+        };
+
+        /**
+         * @brief Web asset compiled into the executable. Everything needed to serve it is computed at build time.
+         */
+        struct EmbeddedAsset
+        {
+            const char*             path;           /**< Path relative to the web directory, separated by '/'. */
+            const unsigned char*    data;           /**< Content of the file. */
+            std::size_t             size;           /**< Size of the content in bytes. */
+            const char*             contentType;    /**< Value of the Content-Type header. */
+            const char*             etag;           /**< Strong entity tag. Hash of the content. */
+            const char*             lastModified;   /**< Value of the Last-Modified header. */
+            std::time_t             modified;       /**< Modification time of the file at build time. */
+            const EmbeddedVariant*  variants;       /**< Compressed variants, most preferred encoding first. */
+            std::size_t             variantCount;   /**< Count of compressed variants. */
+        };
+
+        /**
+         * @brief Table of all embedded files. Generated at build time by the EmbedAssets tool.
+         */
+        extern const EmbeddedAsset assets[];
+
+        /**
+         * @brief Count of entries in the assets table.
+         */
+        extern const std::size_t assetCount;
+    } // Namespace embedded
+} // Namespace primus
+
+#endif // PRIMUSEMBEDDEDASSETS_HPP
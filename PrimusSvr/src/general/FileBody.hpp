@@ -0,0 +1,114 @@
+#ifndef PRIMUSFILEBODY_HPP
+#define PRIMUSFILEBODY_HPP
+
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include "oatpp/web/protocol/http/outgoing/Body.hpp"
+#include "oatpp/core/IODefinitions.hpp"
+
+#include "filesystemHelper.hpp"
+
+namespace primus
+{
+    namespace http
+    {
+        /**
+         * @brief Response body streaming a region of a file from disk.
+         * The file is read chunk by chunk into the transfer buffer of the connection, so memory usage
+         * stays flat no matter how large the file is or how many transfers run at the same time.
+         */
+        class FileBody : public oatpp::web::protocol::http::outgoing::Body
+        {
+        private:
+            std::FILE*      m_file;
+            oatpp::String   m_contentType;
+            v_int64         m_remaining;
+            v_int64         m_length;
+
+        private:
+            FileBody(std::FILE* file, const oatpp::String& contentType, v_int64 length)
+                : m_file(file)
+                , m_contentType(contentType)
+                , m_remaining(length)
+                , m_length(length)
+            {}
+
+        public:
+            FileBody(const FileBody&) = delete;
+            FileBody& operator=(const FileBody&) = delete;
+
+            /**
+             * @brief Destructor for the FileBody class. Closes the file.
+             */
+            ~FileBody(void) override
+            {
+                std::fclose(m_file);
+            }
+
+            /**
+             * @brief Opens a file for streaming.
+             * @param filePath Path of the file.
+             * @param contentType Value of the Content-Type header.
+             * @param offset Position of the first byte to send.
+             * @param length Count of bytes to send.
+             * @return Body for the response or nullptr if the file could not be opened.
+             */
+            static std::shared_ptr<FileBody> createShared(const std::string& filePath, const oatpp::String& contentType, v_int64 offset, v_int64 length)
+            {
+                std::FILE* file = primus::component::filesystem::openFile(filePath, "rb");
+                if (!file)
+                    return nullptr;
+
+#ifdef _WIN32
+                if (_fseeki64(file, offset, SEEK_SET) != 0)
+#else
+                if (fseeko(file, static_cast<off_t>(offset), SEEK_SET) != 0)
+#endif
+                {
+                    std::fclose(file);
+                    return nullptr;
+                }
+
+                return std::shared_ptr<FileBody>(new FileBody(file, contentType, length));
+            }
+
+            v_io_size read(void* buffer, v_buff_size count, oatpp::async::Action& action) override
+            {
+                (void)action;
+
+                if (m_remaining <= 0)
+                    return 0;
+
+                const std::size_t toRead = static_cast<std::size_t>(count < m_remaining ? count : m_remaining);
+                const std::size_t readBytes = std::fread(buffer, 1, toRead, m_file);
+
+                // The file got shorter since the headers were sent. The response can not be completed anymore
+                if (readBytes == 0)
+                    return oatpp::IOError::BROKEN_PIPE;
+
+                m_remaining -= static_cast<v_int64>(readBytes);
+                return static_cast<v_io_size>(readBytes);
+            }
+
+            void declareHeaders(Headers& headers) override
+            {
+                if (m_contentType)
+                    headers.putIfNotExists(oatpp::web::protocol::http::Header::CONTENT_TYPE, m_contentType);
+            }
+
+            p_char8 getKnownData(void) override
+            {
+                return nullptr;
+            }
+
+            v_int64 getKnownSize(void) override
+            {
+                return m_length;
+            }
+        };
+    } // Namespace http
+} // Namespace primus
+
+#endif // PRIMUSFILEBODY_HPP
@@ -0,0 +1,143 @@
+#ifndef PRIMUSIMAGEUPLOADWRITER_HPP
+#define PRIMUSIMAGEUPLOADWRITER_HPP
+
+#include <cstdio>
+#include <cstring>
+
+#include "oatpp/core/data/stream/Stream.hpp"
+#include "oatpp/core/IODefinitions.hpp"
+
+namespace primus
+{
+    namespace http
+    {
+        /**
+         * @brief Receives an uploaded picture and writes it to a file chunk by chunk as it arrives.
+         * The format is identified from the first bytes. Once the upload turned out to be invalid nothing is written anymore,
+         * the rest of the body is only drained. Uploads exceeding the size limit are aborted.
+         */
+        class ImageUploadWriter : public oatpp::data::stream::WriteCallback
+        {
+        public:
+            /**
+             * @brief State of the upload.
+             */
+            enum class Result
+            {
+                Ok,             /**< Valid so far. */
+                Empty,          /**< Not enough data to identify the format. */
+                InvalidFormat,  /**< Neither a JPEG nor a PNG picture. */
+                TooLarge,       /**< Exceeded the size limit. */
+                WriteFailed     /**< The file could not be written. */
+            };
+
+        private:
+            static constexpr std::size_t signatureSize = 8;
+
+            std::FILE*      m_file;
+            v_int64         m_maxSize;
+            v_int64         m_received;
+            unsigned char   m_signature[signatureSize];
+            std::size_t     m_signatureSize;
+            const char*     m_extension;
+            Result          m_result;
+
+        public:
+            /**
+             * @brief Constructor for the ImageUploadWriter class.
+             * @param file File to write to. Stays owned by the caller.
+             * @param maxSize Maximum accepted size of the picture in bytes.
+             */
+            ImageUploadWriter(std::FILE* file, v_int64 maxSize)
+                : m_file(file)
+                , m_maxSize(maxSize)
+                , m_received(0)
+                , m_signatureSize(0)
+                , m_extension(nullptr)
+                , m_result(Result::Ok)
+            {}
+
+            v_io_size write(const void* data, v_buff_size count, oatpp::async::Action& action) override
+            {
+                (void)action;
+
+                m_received += count;
+
+                if (m_received > m_maxSize)
+                {
+                    m_result = Result::TooLarge;
+                    return oatpp::IOError::BROKEN_PIPE;
+                }
+
+                if (m_result != Result::Ok)
+                    return count;
+
+                if (!m_extension && m_signatureSize < signatureSize)
+                {
+                    const std::size_t missing = signatureSize - m_signatureSize;
+                    const std::size_t toCopy = static_cast<std::size_t>(count) < missing ? static_cast<std::size_t>(count) : missing;
+                    std::memcpy(m_signature + m_signatureSize, data, toCopy);
+                    m_signatureSize += toCopy;
+
+                    if (m_signatureSize == signatureSize && !identify())
+                        return count;
+                }
+
+                if (std::fwrite(data, 1, static_cast<std::size_t>(count), m_file) != static_cast<std::size_t>(count))
+                    m_result = Result::WriteFailed;
+
+                return count;
+            }
+
+            /**
+             * @brief Completes the upload after the whole body was received.
+             * @return Final state of the upload.
+             */
+            Result finish(void)
+            {
+                if (m_result == Result::Ok && !m_extension && !identify())
+                    m_result = m_signatureSize == 0 ? Result::Empty : Result::InvalidFormat;
+
+                return m_result;
+            }
+
+            /**
+             * @brief File extension matching the format of the picture, e.g. "jpg". nullptr while the format is unknown.
+             */
+            const char* getExtension(void) const
+            {
+                return m_extension;
+            }
+
+            /**
+             * @brief Count of bytes received so far.
+             */
+            v_int64 getReceived(void) const
+            {
+                return m_received;
+            }
+
+        private:
+            /**
+             * @brief Identifies the format by the collected signature.
+             * @return True for JPEG and PNG pictures.
+             */
+            bool identify(void)
+            {
+                static const unsigned char jpeg[] = { 0xFF, 0xD8, 0xFF };
+                static const unsigned char png[]  = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+                if (m_signatureSize >= sizeof(jpeg) && std::memcmp(m_signature, jpeg, sizeof(jpeg)) == 0)
+                    m_extension = "jpg";
+                else if (m_signatureSize >= sizeof(png) && std::memcmp(m_signature, png, sizeof(png)) == 0)
+                    m_extension = "png";
+                else if (m_signatureSize == signatureSize)
+                    m_result = Result::InvalidFormat;
+
+                return m_extension != nullptr;
+            }
+        };
+    } // Namespace http
+} // Namespace primus
+
+#endif // PRIMUSIMAGEUPLOADWRITER_HPP
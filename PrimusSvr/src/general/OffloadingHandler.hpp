@@ -0,0 +1,156 @@
+#ifndef PRIMUSOFFLOADINGHANDLER_HPP
+#define PRIMUSOFFLOADINGHANDLER_HPP
+
+#include <memory>
+#include <exception>
+
+#include "oatpp/web/server/HttpRequestHandler.hpp"
+#include "oatpp/web/server/HttpRouter.hpp"
+#include "oatpp/web/server/api/ApiController.hpp"
+#include "oatpp/web/protocol/http/Http.hpp"
+#include "oatpp/core/async/Coroutine.hpp"
+
+#include "general/WorkerPool.hpp"
+#include "general/StreamBody.hpp"
+
+namespace primus
+{
+    namespace http
+    {
+        /**
+         * @brief Runs a synchronous endpoint for the asynchronous server.
+         * The endpoint is handed to the worker pool, the coroutine of the connection waits without blocking a thread of the executor.
+         * The connection is switched to blocking reads meanwhile, so endpoints reading the request body work unchanged.
+         */
+        class OffloadingHandler : public oatpp::web::server::HttpRequestHandler
+        {
+            typedef oatpp::web::server::api::ApiController ApiController;
+            typedef primus::worker::WorkerPool WorkerPool;
+            typedef primus::worker::Task Task;
+
+            /**
+             * @brief Response or error of the endpoint, written by the worker.
+             */
+            struct Outcome
+            {
+                std::shared_ptr<OutgoingResponse>   response;
+                std::exception_ptr                  error;
+            };
+
+            class HandleCoroutine : public oatpp::async::CoroutineWithResult<HandleCoroutine, const std::shared_ptr<OutgoingResponse>&>
+            {
+            private:
+                std::shared_ptr<HttpRequestHandler> m_handler;
+                std::shared_ptr<WorkerPool>         m_workers;
+                std::shared_ptr<IncomingRequest>    m_request;
+                std::shared_ptr<Outcome>            m_outcome;
+                std::shared_ptr<Task>               m_task;
+
+            public:
+                HandleCoroutine(const std::shared_ptr<HttpRequestHandler>& handler, const std::shared_ptr<WorkerPool>& workers, const std::shared_ptr<IncomingRequest>& request)
+                    : m_handler(handler)
+                    , m_workers(workers)
+                    , m_request(request)
+                    , m_outcome(std::make_shared<Outcome>())
+                {}
+
+                Action act(void) override
+                {
+                    auto handler = m_handler;
+                    auto request = m_request;
+                    auto outcome = m_outcome;
+
+                    m_task = Task::createShared([handler, request, outcome] {
+                        // The executor does not touch the connection until the response is returned
+                        auto connection = request->getConnection();
+                        connection->setInputStreamIOMode(oatpp::data::stream::IOMode::BLOCKING);
+
+                        try
+                        {
+                            outcome->response = handler->handle(request);
+                        }
+                        catch (...)
+                        {
+                            outcome->error = std::current_exception();
+                        }
+
+                        connection->setInputStreamIOMode(oatpp::data::stream::IOMode::ASYNCHRONOUS);
+                    });
+
+                    if (!m_workers->submit(m_task))
+                        throw oatpp::web::protocol::http::HttpError(Status::CODE_503, "Server busy, try again later");
+
+                    return yieldTo(&HandleCoroutine::onHandled);
+                }
+
+                Action onHandled(void)
+                {
+                    if (!m_task->isDone())
+                        return m_task->waitAsync();
+
+                    if (m_outcome->error)
+                        std::rethrow_exception(m_outcome->error);
+
+                    // Streamed reports read their further pages while the response is sent, these reads go to the pool as well
+                    auto stream = std::dynamic_pointer_cast<StreamBody>(m_outcome->response->getBody());
+                    if (stream)
+                        stream->setWorkerPool(m_workers);
+
+                    return _return(m_outcome->response);
+                }
+            };
+
+        private:
+            std::shared_ptr<ApiController>      m_controller;
+            std::shared_ptr<HttpRequestHandler> m_handler;
+            std::shared_ptr<WorkerPool>         m_workers;
+
+        public:
+            /**
+             * @brief Constructor for the OffloadingHandler class.
+             * @param controller Controller of the endpoint, kept alive as long as the handler.
+             * @param handler Synchronous handler of the endpoint.
+             * @param workers Pool running the handler.
+             */
+            OffloadingHandler(const std::shared_ptr<ApiController>& controller, const std::shared_ptr<HttpRequestHandler>& handler, const std::shared_ptr<WorkerPool>& workers)
+                : m_controller(controller)
+                , m_handler(handler)
+                , m_workers(workers)
+            {}
+
+            std::shared_ptr<OutgoingResponse> handle(const std::shared_ptr<IncomingRequest>& request) override
+            {
+                return m_handler->handle(request);
+            }
+
+            oatpp::async::CoroutineStarterForResult<const std::shared_ptr<OutgoingResponse>&> handleAsync(const std::shared_ptr<IncomingRequest>& request) override
+            {
+                return HandleCoroutine::startForResult(m_handler, m_workers, request);
+            }
+        };
+
+        /**
+         * @brief Adds all endpoints of a controller to the router.
+         * @param router Router of the server.
+         * @param controller Controller to add.
+         * @param workers Worker pool of the asynchronous server, the endpoints run on it. nullptr for the synchronous server.
+         * @return The controller.
+         */
+        inline std::shared_ptr<oatpp::web::server::api::ApiController> route(const std::shared_ptr<oatpp::web::server::HttpRouter>& router,
+            const std::shared_ptr<oatpp::web::server::api::ApiController>& controller, const std::shared_ptr<primus::worker::WorkerPool>& workers)
+        {
+            if (!workers)
+                return router->addController(controller);
+
+            for (const auto& endpoint : controller->getEndpoints().list)
+            {
+                auto info = endpoint->info();
+                router->route(info->method, info->path, std::make_shared<OffloadingHandler>(controller, endpoint->handler, workers));
+            }
+
+            return controller;
+        }
+    } // Namespace http
+} // Namespace primus
+
+#endif // PRIMUSOFFLOADINGHANDLER_HPP
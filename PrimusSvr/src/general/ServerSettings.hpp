@@ -0,0 +1,73 @@
+#ifndef PRIMUSSERVERSETTINGS_HPP
+#define PRIMUSSERVERSETTINGS_HPP
+
+#include <string>
+#include <thread>
+#include <cctype>
+
+#include "general/constants.hpp"
+#include "general/environment.hpp"
+
+namespace primus
+{
+    namespace component
+    {
+        /**
+         * @brief Settings selecting how the server handles connections.
+         * The synchronous server dedicates a thread to every connection. The asynchronous server runs all connections as coroutines on a
+         * few executor threads and hands the endpoints to a bounded worker pool, so idle keep-alive connections and database waits
+         * do not hold a thread each.
+         */
+        struct ServerSettings
+        {
+            std::string     mode;               /**< "sync" or "async". */
+            unsigned int    workers;            /**< Threads of the worker pool of the async server. */
+            unsigned int    queueSize;          /**< Requests which may wait for a worker of the async server. */
+            int             processorThreads;   /**< Threads of the executor running the coroutines of the async server. */
+
+            /**
+             * @brief Reads the settings from the environment. Unset variables keep their defaults from the constants.
+             * Variables: PRIMUS_SERVER_MODE, PRIMUS_SERVER_WORKERS, PRIMUS_SERVER_QUEUE_SIZE and PRIMUS_SERVER_PROCESSORS.
+             * @return The settings.
+             */
+            static ServerSettings fromEnvironment(void)
+            {
+                namespace defaults = primus::constants::server;
+
+                // Every worker may hold a read connection, one more waits for the writer
+                const unsigned int cores = std::thread::hardware_concurrency();
+                const unsigned int workers = (cores > defaults::minWorkers ? cores : defaults::minWorkers) + primus::constants::database::writeConnections;
+
+                ServerSettings settings;
+                settings.mode             = primus::environment::getString("PRIMUS_SERVER_MODE", defaults::mode);
+                settings.workers          = static_cast<unsigned int>(clampCount(primus::environment::getInteger("PRIMUS_SERVER_WORKERS", workers)));
+                settings.queueSize        = static_cast<unsigned int>(clampCount(primus::environment::getInteger("PRIMUS_SERVER_QUEUE_SIZE", defaults::workerQueueSize)));
+                settings.processorThreads = static_cast<int>(clampCount(primus::environment::getInteger("PRIMUS_SERVER_PROCESSORS", defaults::processorThreads)));
+
+                for (auto& c : settings.mode)
+                    c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+
+                if (settings.mode != "async")
+                    settings.mode = "sync";
+
+                return settings;
+            }
+
+            /**
+             * @brief Checks whether the asynchronous server is used.
+             */
+            bool isAsync(void) const
+            {
+                return mode == "async";
+            }
+
+        private:
+            static long long clampCount(long long value)
+            {
+                return value < 1 ? 1 : value > 65536 ? 65536 : value;
+            }
+        };
+    } // Namespace component
+} // Namespace primus
+
+#endif // PRIMUSSERVERSETTINGS_HPP
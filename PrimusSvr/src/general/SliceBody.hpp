@@ -0,0 +1,93 @@
+#ifndef PRIMUSSLICEBODY_HPP
+#define PRIMUSSLICEBODY_HPP
+
+#include <cstring>
+#include <memory>
+
+#include "oatpp/web/protocol/http/outgoing/Body.hpp"
+
+namespace primus
+{
+    namespace http
+    {
+        /**
+         * @brief Response body sending a part of a shared buffer.
+         * The buffer is referenced, not copied, so a cached file can be served in parts to any number of clients.
+         */
+        class SliceBody : public oatpp::web::protocol::http::outgoing::Body
+        {
+        private:
+            std::shared_ptr<const void> m_owner;
+            const char*                 m_data;
+            oatpp::String               m_contentType;
+            v_int64                     m_length;
+            v_int64                     m_position;
+
+        public:
+            /**
+             * @brief Constructor for the SliceBody class.
+             * @param owner Object owning the data. Keeps it alive while the body is sent. May be nullptr for static data.
+             * @param data First byte to send. Must stay unmodified while the body is sent.
+             * @param contentType Value of the Content-Type header. May be nullptr.
+             * @param length Count of bytes to send.
+             */
+            SliceBody(const std::shared_ptr<const void>& owner, const char* data, const oatpp::String& contentType, v_int64 length)
+                : m_owner(owner)
+                , m_data(data)
+                , m_contentType(contentType)
+                , m_length(length)
+                , m_position(0)
+            {}
+
+            /**
+             * @brief Creates a body sending a part of a buffer.
+             */
+            static std::shared_ptr<SliceBody> createShared(const std::shared_ptr<const void>& owner, const char* data, const oatpp::String& contentType, v_int64 length)
+            {
+                return std::make_shared<SliceBody>(owner, data, contentType, length);
+            }
+
+            /**
+             * @brief Creates a body sending a whole string.
+             */
+            static std::shared_ptr<SliceBody> createShared(const oatpp::String& buffer)
+            {
+                return std::make_shared<SliceBody>(buffer.getPtr(), buffer->data(), nullptr, static_cast<v_int64>(buffer->size()));
+            }
+
+            v_io_size read(void* buffer, v_buff_size count, oatpp::async::Action& action) override
+            {
+                (void)action;
+
+                v_int64 toRead = m_length - m_position;
+                if (count < toRead)
+                    toRead = count;
+
+                if (toRead <= 0)
+                    return 0;
+
+                std::memcpy(buffer, m_data + m_position, static_cast<std::size_t>(toRead));
+                m_position += toRead;
+                return static_cast<v_io_size>(toRead);
+            }
+
+            void declareHeaders(Headers& headers) override
+            {
+                if (m_contentType)
+                    headers.putIfNotExists(oatpp::web::protocol::http::Header::CONTENT_TYPE, m_contentType);
+            }
+
+            p_char8 getKnownData(void) override
+            {
+                return reinterpret_cast<p_char8>(const_cast<char*>(m_data));
+            }
+
+            v_int64 getKnownSize(void) override
+            {
+                return m_length;
+            }
+        };
+    } // Namespace http
+} // Namespace primus
+
+#endif // PRIMUSSLICEBODY_HPP
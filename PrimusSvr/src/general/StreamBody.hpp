@@ -0,0 +1,216 @@
+#ifndef PRIMUSSTREAMBODY_HPP
+#define PRIMUSSTREAMBODY_HPP
+
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "oatpp/web/protocol/http/outgoing/Body.hpp"
+#include "oatpp/core/IODefinitions.hpp"
+#include "oatpp/core/data/mapping/ObjectMapper.hpp"
+#include "oatpp/core/Types.hpp"
+
+#include "general/WorkerPool.hpp"
+
+namespace primus
+{
+    namespace http
+    {
+        /**
+         * @brief Response body of unknown size, produced chunk by chunk while it is sent.
+         * The size is unknown in advance, so the response uses chunked transfer encoding. Only one chunk is held in memory at a time.
+         * The asynchronous server hands a worker pool to the body, the chunks are produced on it then.
+         */
+        class StreamBody : public oatpp::web::protocol::http::outgoing::Body
+        {
+        public:
+            /**
+             * @brief Produces the next chunk of the body.
+             * Appends the chunk to the given string and returns false once it was the last one.
+             * Throwing aborts the transfer, the client receives an incomplete response.
+             */
+            typedef std::function<bool(std::string& chunk)> Producer;
+
+        private:
+            /**
+             * @brief Producer and the chunk produced on a worker, shared with the task so it may outlive the body.
+             */
+            struct State
+            {
+                Producer    producer;
+                std::string chunk;
+                bool        more;
+                bool        failed;
+            };
+
+        private:
+            std::shared_ptr<State>                      m_state;
+            oatpp::String                               m_contentType;
+            std::string                                 m_chunk;
+            std::size_t                                 m_position;
+            bool                                        m_finished;
+            std::shared_ptr<primus::worker::WorkerPool> m_workers;
+            std::shared_ptr<primus::worker::Task>       m_task;
+
+        public:
+            /**
+             * @brief Constructor for the StreamBody class.
+             * @param producer Function producing the chunks.
+             * @param contentType Value of the Content-Type header. May be nullptr.
+             */
+            StreamBody(const Producer& producer, const oatpp::String& contentType)
+                : m_state(std::make_shared<State>(State{ producer, std::string(), true, false }))
+                , m_contentType(contentType)
+                , m_position(0)
+                , m_finished(false)
+            {}
+
+            /**
+             * @brief Produces the chunks on a worker pool instead of the thread sending the response.
+             * Only for the asynchronous server, the send coroutine waits for the chunks.
+             */
+            void setWorkerPool(const std::shared_ptr<primus::worker::WorkerPool>& workers)
+            {
+                m_workers = workers;
+            }
+
+            v_io_size read(void* buffer, v_buff_size count, oatpp::async::Action& action) override
+            {
+                // Producers may return empty chunks, keep asking until there is data or the end is reached
+                while (m_position >= m_chunk.size())
+                {
+                    if (m_finished)
+                        return 0;
+
+                    if (m_workers && !m_task)
+                        startTask();
+
+                    if (m_task)
+                    {
+                        if (!m_task->isDone())
+                        {
+                            action = m_task->waitAsync();
+                            return oatpp::IOError::RETRY_READ;
+                        }
+
+                        m_task.reset();
+                        if (m_state->failed)
+                            return oatpp::IOError::BROKEN_PIPE;
+
+                        m_chunk.swap(m_state->chunk);
+                        m_position = 0;
+                        m_finished = !m_state->more;
+                        continue;
+                    }
+
+                    m_chunk.clear();
+                    m_position = 0;
+
+                    try
+                    {
+                        m_finished = !m_state->producer(m_chunk);
+                    }
+                    catch (const std::exception&)
+                    {
+                        return oatpp::IOError::BROKEN_PIPE;
+                    }
+                }
+
+                const std::size_t available = m_chunk.size() - m_position;
+                const std::size_t toCopy = static_cast<std::size_t>(count) < available ? static_cast<std::size_t>(count) : available;
+
+                std::memcpy(buffer, m_chunk.data() + m_position, toCopy);
+                m_position += toCopy;
+
+                return static_cast<v_io_size>(toCopy);
+            }
+
+            void declareHeaders(Headers& headers) override
+            {
+                if (m_contentType)
+                    headers.putIfNotExists(oatpp::web::protocol::http::Header::CONTENT_TYPE, m_contentType);
+            }
+
+            p_char8 getKnownData(void) override
+            {
+                return nullptr;
+            }
+
+            v_int64 getKnownSize(void) override
+            {
+                return -1;
+            }
+
+        private:
+            void startTask(void)
+            {
+                auto state = m_state;
+                m_task = primus::worker::Task::createShared([state] {
+                    state->chunk.clear();
+
+                    try
+                    {
+                        state->more = state->producer(state->chunk);
+                    }
+                    catch (const std::exception&)
+                    {
+                        state->failed = true;
+                    }
+                });
+
+                // A full pool would delay the response indefinitely, the chunk is produced right here then
+                if (!m_workers->submit(m_task))
+                    m_task.reset();
+            }
+        };
+
+        /**
+         * @brief Streams a report as JSON array, read page by page along the ids of its items.
+         * The first page is read right away, so errors of the database are thrown before the response starts. Every further page is
+         * read once the previous one was sent, memory usage does not grow with the length of the report.
+         * @param fetchPage Reads the page following the item with the given id, 0 for the first page. Items have to be sorted by id.
+         * @param pageSize Count of items of a full page, a shorter page is the last one.
+         * @param objectMapper Mapper serializing the items.
+         * @param prefix Text in front of the array, e.g. to embed it into an object.
+         * @param trailer Appends the text behind the array once the last page was sent. May be nullptr.
+         * @return The response body.
+         */
+        template<class Dto>
+        std::shared_ptr<StreamBody> createKeysetArrayBody(const std::function<oatpp::Vector<oatpp::Object<Dto>>(v_uint32 afterId)>& fetchPage, v_uint32 pageSize,
+            const std::shared_ptr<oatpp::data::mapping::ObjectMapper>& objectMapper, const std::string& prefix = "", const std::function<void(std::string& chunk)>& trailer = nullptr)
+        {
+            auto page = fetchPage(0);
+            bool first = true;
+
+            auto producer = [fetchPage, pageSize, objectMapper, prefix, trailer, page, first](std::string& chunk) mutable -> bool {
+                if (first)
+                    chunk += prefix + "[";
+
+                for (const auto& item : *page)
+                {
+                    if (!first)
+                        chunk += ',';
+                    first = false;
+                    chunk += *objectMapper->writeToString(item);
+                }
+
+                if (page->size() < pageSize)
+                {
+                    chunk += ']';
+                    if (trailer)
+                        trailer(chunk);
+                    return false;
+                }
+
+                page = fetchPage(page->back()->id);
+                return true;
+            };
+
+            return std::make_shared<StreamBody>(producer, "application/json");
+        }
+    } // Namespace http
+} // Namespace primus
+
+#endif // PRIMUSSTREAMBODY_HPP
@@ -0,0 +1,213 @@
+#ifndef PRIMUSWORKERPOOL_HPP
+#define PRIMUSWORKERPOOL_HPP
+
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+#include "oatpp/core/async/Coroutine.hpp"
+#include "oatpp/core/async/CoroutineWaitList.hpp"
+
+#include "general/constants.hpp"
+
+namespace primus
+{
+    namespace worker
+    {
+        /**
+         * @brief Blocking job handed from a coroutine to the WorkerPool.
+         * The coroutine waits on the wait list of the task, so no thread of the executor is blocked meanwhile.
+         */
+        class Task : private oatpp::async::CoroutineWaitList::Listener
+        {
+            static constexpr const char* logName = primus::constants::server::logName;
+
+        public:
+            typedef std::function<void(void)> Function;
+
+        private:
+            Function                        m_function;
+            std::atomic<bool>               m_done;
+            oatpp::async::CoroutineWaitList m_waitList;
+
+        public:
+            /**
+             * @brief Constructor for the Task class.
+             * @param function Job to run. Results and errors have to be passed on by the job itself.
+             */
+            explicit Task(const Function& function)
+                : m_function(function)
+                , m_done(false)
+            {
+                m_waitList.setListener(this);
+            }
+
+            Task(const Task&) = delete;
+            Task& operator=(const Task&) = delete;
+
+            /**
+             * @brief Creates a shared pointer to a Task instance.
+             */
+            static std::shared_ptr<Task> createShared(const Function& function)
+            {
+                return std::make_shared<Task>(function);
+            }
+
+            /**
+             * @brief Checks whether the job has been run. Everything the job wrote is visible once this returns true.
+             */
+            bool isDone(void) const
+            {
+                return m_done;
+            }
+
+            /**
+             * @brief Suspends the calling coroutine until the job has been run.
+             * The coroutine repeats its current step when it is woken up, so the step has to check isDone() again.
+             */
+            oatpp::async::Action waitAsync(void)
+            {
+                return oatpp::async::Action::createWaitListAction(&m_waitList);
+            }
+
+            /**
+             * @brief Runs the job and wakes up the waiting coroutines. Called by the WorkerPool.
+             */
+            void run(void)
+            {
+                try
+                {
+                    m_function();
+                }
+                catch (const std::exception& e)
+                {
+                    OATPP_LOGE(logName, "Task failed: %s", e.what());
+                }
+
+                // Captured state is released right away, not when the last waiting coroutine is done
+                m_function = nullptr;
+
+                m_done = true;
+                m_waitList.notifyAll();
+            }
+
+        private:
+            // A coroutine may start waiting only after the job was done, it is woken up right away then
+            void onNewItem(oatpp::async::CoroutineWaitList& list) override
+            {
+                if (m_done)
+                    list.notifyAll();
+            }
+        };
+
+        /**
+         * @brief Fixed set of threads running blocking jobs, e.g. database queries, for the asynchronous server.
+         * The count of waiting tasks is bounded, a full pool rejects new tasks instead of letting the latency grow without limit.
+         */
+        class WorkerPool
+        {
+        private:
+            std::deque<std::shared_ptr<Task>>   m_queue;
+            std::size_t                         m_maxQueued;
+            std::mutex                          m_lock;
+            std::condition_variable             m_wakeup;
+            bool                                m_stop;
+            std::vector<std::thread>            m_workers;
+
+        private:
+            WorkerPool(unsigned int threads, std::size_t maxQueued)
+                : m_maxQueued(maxQueued)
+                , m_stop(false)
+            {
+                m_workers.reserve(threads);
+                for (unsigned int i = 0; i < threads; ++i)
+                    m_workers.emplace_back(&WorkerPool::run, this);
+            }
+
+        public:
+            WorkerPool(const WorkerPool&) = delete;
+            WorkerPool& operator=(const WorkerPool&) = delete;
+
+            /**
+             * Destructor. Stops the workers, tasks which did not start yet are dropped.
+             */
+            ~WorkerPool(void)
+            {
+                {
+                    std::lock_guard<std::mutex> guard(m_lock);
+                    m_stop = true;
+                }
+
+                m_wakeup.notify_all();
+                for (auto& worker : m_workers)
+                    worker.join();
+            }
+
+            /**
+             * Creates the pool and starts its workers.
+             * @param threads - count of workers, at least one is started.
+             * @param maxQueued - count of tasks which may wait for a worker.
+             * @return Shared pointer to the pool.
+             */
+            static std::shared_ptr<WorkerPool> createShared(unsigned int threads, std::size_t maxQueued)
+            {
+                return std::shared_ptr<WorkerPool>(new WorkerPool(threads > 0 ? threads : 1, maxQueued));
+            }
+
+            /**
+             * Queues a task for the next free worker.
+             * @param task - task to run.
+             * @return False if the queue is full, the task is not run then.
+             */
+            bool submit(const std::shared_ptr<Task>& task)
+            {
+                {
+                    std::lock_guard<std::mutex> guard(m_lock);
+                    if (m_stop || m_queue.size() >= m_maxQueued)
+                        return false;
+
+                    m_queue.push_back(task);
+                }
+
+                m_wakeup.notify_one();
+                return true;
+            }
+
+            /**
+             * Retrieves the count of workers.
+             */
+            std::size_t getSize(void) const
+            {
+                return m_workers.size();
+            }
+
+        private:
+            void run(void)
+            {
+                std::unique_lock<std::mutex> lock(m_lock);
+
+                while (true)
+                {
+                    m_wakeup.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+                    if (m_stop)
+                        return;
+
+                    std::shared_ptr<Task> task = m_queue.front();
+                    m_queue.pop_front();
+
+                    lock.unlock();
+                    task->run();
+                    lock.lock();
+                }
+            }
+        };
+    } // Namespace worker
+} // Namespace primus
+
+#endif // PRIMUSWORKERPOOL_HPP
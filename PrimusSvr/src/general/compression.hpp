@@ -0,0 +1,85 @@
+#ifndef PRIMUSCOMPRESSION_HPP
+#define PRIMUSCOMPRESSION_HPP
+
+#include <string>
+
+#ifdef PRIMUS_WITH_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef PRIMUS_WITH_BROTLI
+#include <brotli/encode.h>
+#endif
+
+namespace primus
+{
+    namespace compression
+    {
+        /**
+         * @brief Compresses a buffer into the gzip format using the highest compression level.
+         * @param input Data to compress.
+         * @param output Receives the compressed data.
+         * @return True on success. False if compression failed or gzip support was not compiled in.
+         */
+        inline bool gzip(const std::string& input, std::string& output)
+        {
+#ifdef PRIMUS_WITH_ZLIB
+            z_stream stream{};
+
+            // 15 window bits + 16 selects the gzip wrapper instead of the zlib one
+            if (deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, 15 + 16, 9, Z_DEFAULT_STRATEGY) != Z_OK)
+                return false;
+
+            output.resize(deflateBound(&stream, static_cast<uLong>(input.size())));
+
+            stream.next_in   = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+            stream.avail_in  = static_cast<uInt>(input.size());
+            stream.next_out  = reinterpret_cast<Bytef*>(&output[0]);
+            stream.avail_out = static_cast<uInt>(output.size());
+
+            const int result = deflate(&stream, Z_FINISH);
+            output.resize(stream.total_out);
+            deflateEnd(&stream);
+
+            return result == Z_STREAM_END;
+#else
+            (void)input;
+            (void)output;
+            return false;
+#endif
+        }
+
+        /**
+         * @brief Compresses a buffer into the brotli format using the highest compression quality.
+         * @param input Data to compress.
+         * @param output Receives the compressed data.
+         * @return True on success. False if compression failed or brotli support was not compiled in.
+         */
+        inline bool brotli(const std::string& input, std::string& output)
+        {
+#ifdef PRIMUS_WITH_BROTLI
+            std::size_t size = BrotliEncoderMaxCompressedSize(input.size());
+            if (size == 0)
+                return false;
+
+            output.resize(size);
+
+            if (!BrotliEncoderCompress(BROTLI_MAX_QUALITY, BROTLI_DEFAULT_WINDOW, BROTLI_MODE_TEXT,
+                input.size(), reinterpret_cast<const uint8_t*>(input.data()),
+                &size, reinterpret_cast<uint8_t*>(&output[0])))
+            {
+                return false;
+            }
+
+            output.resize(size);
+            return true;
+#else
+            (void)input;
+            (void)output;
+            return false;
+#endif
+        }
+    } // Namespace compression
+} // Namespace primus
+
+#endif // PRIMUSCOMPRESSION_HPP
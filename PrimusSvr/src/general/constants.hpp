@@ -10,16 +10,75 @@ namespace primus
 
 		namespace main				  { constexpr char logName[logNameLength] = "Startup            ";} // Namespace main
 									  
+		namespace server {
+			constexpr char logName[logNameLength] = "Server             ";
+			constexpr char mode[] = "sync";               // "sync": one thread per connection, "async": coroutines on an executor, see ServerSettings
+			constexpr unsigned int minWorkers = 2;        // Lower bound of the worker pool of the async server, which is sized to the core count otherwise
+			constexpr unsigned int workerQueueSize = 256; // Requests waiting for a worker, further requests are answered with 503
+			constexpr int processorThreads = 1;           // Threads of the executor running the coroutines
+			constexpr int ioThreads = 1;                  // Threads of the executor waiting for the connections
+			constexpr int timerThreads = 1;               // Threads of the executor waking up timed coroutines
+		} // Namespace server
+
 		namespace databaseclient	  { constexpr char logName[logNameLength] = "DatabaseClient     ";} // Namespace databaseclient
 
+		namespace database {
+			constexpr char logName[logNameLength] = "DatabaseConnection ";
+			constexpr char journalMode[]       = "WAL";      // Readers do not block the writer and vice versa
+			constexpr char synchronous[]       = "NORMAL";   // Sync on checkpoints only. Safe from corruption in WAL mode
+			constexpr char tempStore[]         = "MEMORY";
+			constexpr long long mmapSize       = 256LL * 1024 * 1024; // Bytes of the database file mapped into memory
+			constexpr long long cacheSize      = 16 * 1024;  // Page cache per connection in KiB
+			constexpr long long busyTimeout    = 5000;       // Milliseconds to wait for a lock before failing with SQLITE_BUSY
+			constexpr long long checkpointInterval = 60;     // Seconds between two WAL checkpoints, 0 disables them
+			constexpr unsigned int writeConnections = 1;     // Writes are serialized in the pool instead of failing with SQLITE_BUSY
+			constexpr unsigned int minReadConnections = 2;   // Lower bound of the read pool, which is sized to the core count otherwise
+			constexpr unsigned int connectionTTL = 5;        // Seconds an idle pooled connection is kept open
+			constexpr char readPoolQualifier[] = "database-read"; // Qualifier of the read-only connection pool component
+		} // Namespace database
+
 		namespace managers {
 			namespace manager_member { constexpr char logName[logNameLength] = "MemberManager      "; } // Namespace manager_member
-			namespace manager_static { constexpr char logName[logNameLength] = "StaticManager      "; } // Namespace manager_static
+			namespace manager_static {
+				constexpr char logName[logNameLength] = "StaticManager      ";
+				constexpr unsigned int revalidateSeconds = 2; // Minimum time between two checks of a cached file for modifications
+				constexpr long long minCompressSize = 256; // Smaller files are not compressed, the framing overhead eats the savings
+				constexpr long long maxCachedFileSize = 1024 * 1024; // Larger files are streamed from disk instead of being kept in memory
+			} // Namespace manager_static
+			namespace manager_avatar {
+				constexpr char logName[logNameLength] = "AvatarManager      ";
+				constexpr const char* defaultAvatars[] = { "default-avatar-1.jpg", "default-avatar-2.jpg" }; // Served to members without a picture of their own
+				constexpr const char* extensions[] = { "jpg", "png" };  // Accepted formats of the pictures, looked up in this order
+			} // Namespace manager_avatar
+			namespace manager_thumbnail {
+				constexpr char logName[logNameLength] = "ThumbnailManager   ";
+				constexpr unsigned int sizes[] = { 48, 128, 512 }; // Edge lengths of the thumbnails in pixels, ascending
+				constexpr int quality = 85;                        // JPEG quality of the thumbnails
+			} // Namespace manager_thumbnail
+			namespace manager_leaderboard { constexpr char logName[logNameLength] = "LeaderboardManager "; } // Namespace manager_leaderboard
+			namespace manager_birthday { constexpr char logName[logNameLength] = "BirthdayManager    "; } // Namespace manager_birthday
+			namespace manager_attendance { constexpr char logName[logNameLength] = "AttendanceIndex    "; } // Namespace manager_attendance
+			namespace manager_registry { constexpr char logName[logNameLength] = "MemberRegistry     "; } // Namespace manager_registry
+			namespace manager_fee { constexpr char logName[logNameLength] = "FeeManager         "; } // Namespace manager_fee
 		} // Namespace managers
 
 		namespace apicontroller { 
-			namespace static_endpoint { constexpr char logName[logNameLength] = "StaticEndpoint     ";} // Namespace static_endpoint
-			namespace member_endpoint { constexpr char logName[logNameLength] = "MemberEndpoint     ";} // Namespace member_endpoint
+			namespace static_endpoint {
+				constexpr char logName[logNameLength] = "StaticEndpoint     ";
+				constexpr char cacheControlWeb[]    = "public, no-cache";  // Browsers keep the files but revalidate them on every use
+				constexpr char cacheControlAvatar[] = "private, no-cache";
+				constexpr std::size_t maxRanges = 16;              // Requests asking for more ranges get the whole file
+				constexpr long long maxAvatarUploadSize = 10 * 1024 * 1024; // Larger uploads of profile pictures are rejected
+			} // Namespace static_endpoint
+			namespace member_endpoint {
+				constexpr char logName[logNameLength] = "MemberEndpoint     ";
+				constexpr char cursorMembers[]     = "member";     // Kind of the page tokens of the member lists, sorted by id
+				constexpr char cursorAttendances[] = "attendance"; // Kind of the page tokens of the attendance lists, sorted by date
+				constexpr unsigned int reportPageSize = 256;        // Members read from the database at once while a report is streamed
+				constexpr unsigned int profileListLimit = 10;       // Addresses and departments shown on the profile of a member
+				constexpr unsigned int profileAttendanceLimit = 5;  // Attendances shown on the profile of a member, unless a limit is given
+				constexpr unsigned int batchMaxIds = 500;           // Members which can be requested at once, see the batch endpoints
+			} // Namespace member_endpoint
 		} // Namespace apicontroller
 
 	} // Namespace constants
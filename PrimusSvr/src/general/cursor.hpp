@@ -0,0 +1,84 @@
+#ifndef PRIMUSCURSOR_HPP
+#define PRIMUSCURSOR_HPP
+
+#include <string>
+#include <cstdlib>
+#include <cerrno>
+
+#include "oatpp/core/Types.hpp"
+#include "oatpp/encoding/Base64.hpp"
+
+namespace primus
+{
+    namespace cursor
+    {
+        /**
+         * @brief Encodes the sort key of the last item of a page into an opaque token for keyset pagination.
+         * @param kind Kind of list the token belongs to. Tokens of one kind are rejected by lists of another kind.
+         * @param key Sort key of the last item.
+         * @return The token, safe to use in URLs.
+         */
+        inline oatpp::String encode(const char* kind, const std::string& key)
+        {
+            return oatpp::encoding::Base64::encode(std::string(kind) + ":" + key, oatpp::encoding::Base64::ALPHABET_BASE64_URL_SAFE);
+        }
+
+        /**
+         * @brief Decodes a token created by encode.
+         * @param token The token.
+         * @param kind Expected kind of list.
+         * @param key Receives the sort key.
+         * @return False if the token is malformed or belongs to another kind of list.
+         */
+        inline bool decode(const oatpp::String& token, const char* kind, std::string& key)
+        {
+            if (!token)
+                return false;
+
+            oatpp::String decoded;
+            try
+            {
+                decoded = oatpp::encoding::Base64::decode(token, oatpp::encoding::Base64::ALPHABET_BASE64_URL_SAFE_AUXILIARY_CHARS);
+            }
+            catch (const oatpp::encoding::Base64::DecodingError&)
+            {
+                return false;
+            }
+
+            const std::string prefix = std::string(kind) + ":";
+            if (!decoded || decoded->compare(0, prefix.size(), prefix) != 0)
+                return false;
+
+            key = decoded->substr(prefix.size());
+            return true;
+        }
+
+        /**
+         * @brief Encodes a numeric sort key, see encode.
+         */
+        inline oatpp::String encodeId(const char* kind, v_uint32 id)
+        {
+            return encode(kind, std::to_string(id));
+        }
+
+        /**
+         * @brief Decodes a token holding a numeric sort key, see decode.
+         */
+        inline bool decodeId(const oatpp::String& token, const char* kind, v_uint32& id)
+        {
+            std::string key;
+            if (!decode(token, kind, key) || key.empty() || key.find_first_not_of("0123456789") != std::string::npos)
+                return false;
+
+            errno = 0;
+            const unsigned long long value = std::strtoull(key.c_str(), nullptr, 10);
+            if (errno != 0 || value > 0xFFFFFFFFull)
+                return false;
+
+            id = static_cast<v_uint32>(value);
+            return true;
+        }
+    } // Namespace cursor
+} // Namespace primus
+
+#endif // PRIMUSCURSOR_HPP
@@ -0,0 +1,144 @@
+#ifndef PRIMUSDATE_HPP
+#define PRIMUSDATE_HPP
+
+#include <string>
+#include <ctime>
+#include <cstdio>
+
+namespace primus
+{
+    namespace date
+    {
+        /**
+         * @brief Formats a point in time as HTTP date (RFC 7231), e.g. "Sun, 06 Nov 1994 08:49:37 GMT".
+         * @param time Point in time to format.
+         * @return Formatted date.
+         */
+        inline std::string formatHttpDate(std::time_t time)
+        {
+            static const char* const weekdays[] = { "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat" };
+            static const char* const months[]   = { "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+
+            std::tm utc;
+#ifdef _WIN32
+            gmtime_s(&utc, &time);
+#else
+            gmtime_r(&time, &utc);
+#endif
+
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "%s, %02d %s %04d %02d:%02d:%02d GMT",
+                weekdays[utc.tm_wday], utc.tm_mday, months[utc.tm_mon], utc.tm_year + 1900, utc.tm_hour, utc.tm_min, utc.tm_sec);
+
+            return buffer;
+        }
+
+        /**
+         * @brief Formats the day of a point in time as "MM-DD" (UTC), the same as strftime('%m-%d', ...) of SQLite.
+         * @param time Point in time to format.
+         * @return Formatted day.
+         */
+        inline std::string formatMonthDay(std::time_t time)
+        {
+            std::tm utc;
+#ifdef _WIN32
+            gmtime_s(&utc, &time);
+#else
+            gmtime_r(&time, &utc);
+#endif
+
+            char buffer[8];
+            std::snprintf(buffer, sizeof(buffer), "%02d-%02d", utc.tm_mon + 1, utc.tm_mday);
+
+            return buffer;
+        }
+
+        /**
+         * @brief Converts a date of the proleptic Gregorian calendar to the count of days since 1970-01-01.
+         * Days beyond the end of the month roll over into the next month, just like SQLite does, e.g. 2023-02-29 is 2023-03-01.
+         * @param year Year, e.g. 2024.
+         * @param month Month, 1 to 12.
+         * @param day Day of the month, starting at 1.
+         * @return Count of days since 1970-01-01, negative for earlier dates.
+         */
+        inline int daysFromCivil(int year, int month, int day)
+        {
+            year -= month <= 2 ? 1 : 0;
+            const int era = (year >= 0 ? year : year - 399) / 400;
+            const int yearOfEra = year - era * 400;
+            const int dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+            const int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+            return era * 146097 + dayOfEra - 719468;
+        }
+
+        /**
+         * @brief Converts a count of days since 1970-01-01 to a date of the proleptic Gregorian calendar.
+         * @param days Count of days since 1970-01-01.
+         * @param year Receives the year.
+         * @param month Receives the month, 1 to 12.
+         * @param day Receives the day of the month, starting at 1.
+         */
+        inline void civilFromDays(int days, int& year, int& month, int& day)
+        {
+            days += 719468;
+            const int era = (days >= 0 ? days : days - 146096) / 146097;
+            const int dayOfEra = days - era * 146097;
+            const int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+            const int dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+            const int shiftedMonth = (5 * dayOfYear + 2) / 153;
+
+            day = dayOfYear - (153 * shiftedMonth + 2) / 5 + 1;
+            month = shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9;
+            year = yearOfEra + era * 400 + (month <= 2 ? 1 : 0);
+        }
+
+        /**
+         * @brief Parses a date in the format YYYY-MM-DD.
+         * @param text Date to parse.
+         * @param days Receives the count of days since 1970-01-01.
+         * @return True if the text is a valid date.
+         */
+        inline bool parseDay(const std::string& text, int& days)
+        {
+            if (text.size() != 10 || text[4] != '-' || text[7] != '-')
+                return false;
+
+            int fields[3] = { 0, 0, 0 };
+            const std::size_t starts[3] = { 0, 5, 8 };
+            const std::size_t lengths[3] = { 4, 2, 2 };
+
+            for (int field = 0; field < 3; ++field)
+            {
+                for (std::size_t i = starts[field]; i < starts[field] + lengths[field]; ++i)
+                {
+                    if (text[i] < '0' || text[i] > '9')
+                        return false;
+                    fields[field] = fields[field] * 10 + (text[i] - '0');
+                }
+            }
+
+            if (fields[1] < 1 || fields[1] > 12 || fields[2] < 1 || fields[2] > 31)
+                return false;
+
+            // Days beyond the end of the month, e.g. 2023-02-30, would roll over into the next month
+            int year, month, day;
+            civilFromDays(daysFromCivil(fields[0], fields[1], fields[2]), year, month, day);
+            if (month != fields[1] || day != fields[2])
+                return false;
+
+            days = daysFromCivil(fields[0], fields[1], fields[2]);
+            return true;
+        }
+
+        /**
+         * @brief Retrieves the current day (UTC), the same as date('now') of SQLite.
+         * @return Count of days since 1970-01-01.
+         */
+        inline int today(void)
+        {
+            return static_cast<int>(std::time(nullptr) / 86400);
+        }
+    } // Namespace date
+} // Namespace primus
+
+#endif // PRIMUSDATE_HPP
@@ -0,0 +1,59 @@
+#ifndef PRIMUSENVIRONMENT_HPP
+#define PRIMUSENVIRONMENT_HPP
+
+#include <string>
+#include <cstdlib>
+#include <cerrno>
+
+namespace primus
+{
+    namespace environment
+    {
+        /**
+         * @brief Reads an environment variable.
+         * @param name Name of the variable.
+         * @param fallback Returned if the variable is not set or empty.
+         * @return Value of the variable.
+         */
+        inline std::string getString(const char* name, const std::string& fallback)
+        {
+#ifdef _WIN32
+            char* value = nullptr;
+            std::size_t length = 0;
+            if (_dupenv_s(&value, &length, name) != 0 || value == nullptr)
+                return fallback;
+
+            const std::string result(value);
+            std::free(value);
+#else
+            const char* value = std::getenv(name);
+            if (value == nullptr)
+                return fallback;
+
+            const std::string result(value);
+#endif
+            return result.empty() ? fallback : result;
+        }
+
+        /**
+         * @brief Reads an environment variable holding an integer.
+         * @param name Name of the variable.
+         * @param fallback Returned if the variable is not set or not a valid integer.
+         * @return Value of the variable.
+         */
+        inline long long getInteger(const char* name, long long fallback)
+        {
+            const std::string value = getString(name, "");
+            if (value.empty())
+                return fallback;
+
+            char* end = nullptr;
+            errno = 0;
+            const long long result = std::strtoll(value.c_str(), &end, 10);
+
+            return errno == 0 && end != value.c_str() && *end == '\0' ? result : fallback;
+        }
+    } // Namespace environment
+} // Namespace primus
+
+#endif // PRIMUSENVIRONMENT_HPP
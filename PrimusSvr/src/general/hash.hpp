@@ -0,0 +1,53 @@
+#ifndef PRIMUSHASH_HPP
+#define PRIMUSHASH_HPP
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+namespace primus
+{
+    namespace hash
+    {
+        /**
+         * @brief Computes the 64 bit FNV-1a hash of a buffer.
+         * @param data Pointer to the first byte.
+         * @param size Count of bytes to hash.
+         * @return Hash value.
+         */
+        inline uint64_t fnv1a64(const void* data, std::size_t size)
+        {
+            const unsigned char* bytes = static_cast<const unsigned char*>(data);
+            uint64_t hash = 14695981039346656037ULL;
+
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                hash ^= bytes[i];
+                hash *= 1099511628211ULL;
+            }
+
+            return hash;
+        }
+
+        /**
+         * @brief Formats a value as fixed width lowercase hexadecimal string.
+         * @param value Value to format.
+         * @return 16 character hexadecimal representation.
+         */
+        inline std::string toHex(uint64_t value)
+        {
+            static const char digits[] = "0123456789abcdef";
+            std::string hex(16, '0');
+
+            for (int i = 15; i >= 0; --i)
+            {
+                hex[i] = digits[value & 0xF];
+                value >>= 4;
+            }
+
+            return hex;
+        }
+    } // Namespace hash
+} // Namespace primus
+
+#endif // PRIMUSHASH_HPP
@@ -0,0 +1,75 @@
+#ifndef PRIMUSMIME_HPP
+#define PRIMUSMIME_HPP
+
+#include <map>
+#include <string>
+#include <cctype>
+
+namespace primus
+{
+    namespace mime
+    {
+        /**
+         * @brief Determines the value of the Content-Type header for a file by its extension.
+         * @param path Path or name of the file.
+         * @return Mime type of the file. "application/octet-stream" for unknown extensions.
+         */
+        inline const char* getContentType(const std::string& path)
+        {
+            static const std::map<std::string, const char*> mimeTypes =
+            {
+                {"html" , "text/html; charset=utf-8"},
+                {"htm"  , "text/html; charset=utf-8"},
+                {"css"  , "text/css; charset=utf-8"},
+                {"js"   , "application/javascript; charset=utf-8"},
+                {"json" , "application/json"},
+                {"txt"  , "text/plain; charset=utf-8"},
+                {"svg"  , "image/svg+xml"},
+                {"jpg"  , "image/jpeg"},
+                {"jpeg" , "image/jpeg"},
+                {"png"  , "image/png"},
+                {"gif"  , "image/gif"},
+                {"ico"  , "image/x-icon"},
+                {"webp" , "image/webp"},
+                {"woff" , "font/woff"},
+                {"woff2", "font/woff2"},
+                {"ttf"  , "font/ttf"},
+                {"pdf"  , "application/pdf"},
+                {"csv"  , "text/csv; charset=utf-8"},
+                {"mp4"  , "video/mp4"},
+                {"webm" , "video/webm"}
+            };
+
+            const auto dotPos = path.find_last_of('.');
+            if (dotPos == std::string::npos)
+                return "application/octet-stream";
+
+            std::string extension = path.substr(dotPos + 1);
+            for (auto& c : extension)
+                c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+
+            auto it = mimeTypes.find(extension);
+            if (it != mimeTypes.end())
+                return it->second;
+
+            return "application/octet-stream";
+        }
+
+        /**
+         * @brief Checks whether content of a mime type benefits from compression.
+         * Images, fonts and videos are already compressed and are left alone.
+         * @param contentType Value of the Content-Type header.
+         * @return True for text based formats.
+         */
+        inline bool isCompressible(const std::string& contentType)
+        {
+            return contentType.compare(0, 5, "text/") == 0
+                || contentType.compare(0, 22, "application/javascript") == 0
+                || contentType.compare(0, 16, "application/json") == 0
+                || contentType.compare(0, 13, "image/svg+xml") == 0
+                || contentType.compare(0, 12, "image/x-icon") == 0;
+        }
+    } // Namespace mime
+} // Namespace primus
+
+#endif // PRIMUSMIME_HPP
@@ -0,0 +1,158 @@
+#ifndef PRIMUSRANGE_HPP
+#define PRIMUSRANGE_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cctype>
+#include <algorithm>
+
+namespace primus
+{
+    namespace http
+    {
+        /**
+         * @brief Inclusive byte range of a representation.
+         */
+        struct ByteRange
+        {
+            int64_t first;  /**< Position of the first byte. */
+            int64_t last;   /**< Position of the last byte. */
+        };
+
+        /**
+         * @brief Outcome of parsing a Range header.
+         */
+        enum class RangeResult
+        {
+            Ignore,         /**< No usable Range header. The whole representation is sent. */
+            Satisfiable,    /**< At least one range overlaps the representation. */
+            Unsatisfiable   /**< None of the ranges overlaps the representation. */
+        };
+
+        /**
+         * @brief Parses a non-negative decimal number.
+         * @param text Text to parse.
+         * @param value Receives the number.
+         * @return False if the text is empty, contains anything but digits or overflows.
+         */
+        inline bool parseRangeNumber(const std::string& text, int64_t& value)
+        {
+            if (text.empty())
+                return false;
+
+            value = 0;
+            for (char c : text)
+            {
+                if (!std::isdigit(static_cast<unsigned char>(c)) || value > (INT64_MAX - 9) / 10)
+                    return false;
+                value = value * 10 + (c - '0');
+            }
+
+            return true;
+        }
+
+        /**
+         * @brief Parses the value of a Range header (RFC 7233), e.g. "bytes=0-499, 1000-, -200".
+         * Overlapping and adjacent ranges are merged and the result is sorted.
+         * Malformed headers, units other than bytes and requests with more than maxRanges ranges are ignored.
+         * @param header Value of the Range header.
+         * @param length Size of the representation in bytes.
+         * @param maxRanges Maximum count of ranges accepted in one request.
+         * @param ranges Receives the requested ranges.
+         * @return How the request has to be answered.
+         */
+        inline RangeResult parseRange(const std::string& header, int64_t length, std::size_t maxRanges, std::vector<ByteRange>& ranges)
+        {
+            ranges.clear();
+
+            if (header.size() < 6)
+                return RangeResult::Ignore;
+
+            std::string unit = header.substr(0, 6);
+            for (auto& c : unit)
+                c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            if (unit != "bytes=")
+                return RangeResult::Ignore;
+
+            std::size_t start = 6;
+            std::size_t count = 0;
+
+            while (start <= header.size())
+            {
+                std::size_t end = header.find(',', start);
+                if (end == std::string::npos)
+                    end = header.size();
+
+                std::string spec = header.substr(start, end - start);
+                spec.erase(0, spec.find_first_not_of(" \t"));
+                spec.erase(spec.find_last_not_of(" \t") + 1);
+                start = end + 1;
+
+                // Empty list elements are allowed by the grammar
+                if (spec.empty())
+                    continue;
+
+                if (++count > maxRanges)
+                    return RangeResult::Ignore;
+
+                const std::size_t dash = spec.find('-');
+                if (dash == std::string::npos)
+                    return RangeResult::Ignore;
+
+                ByteRange range;
+                int64_t value;
+
+                if (dash == 0)
+                {
+                    // Suffix range: the last n bytes
+                    if (!parseRangeNumber(spec.substr(1), value))
+                        return RangeResult::Ignore;
+                    if (value == 0 || length == 0)
+                        continue;
+
+                    range.first = value < length ? length - value : 0;
+                    range.last = length - 1;
+                }
+                else
+                {
+                    if (!parseRangeNumber(spec.substr(0, dash), range.first))
+                        return RangeResult::Ignore;
+
+                    if (dash + 1 == spec.size())
+                        range.last = length - 1;
+                    else if (!parseRangeNumber(spec.substr(dash + 1), range.last) || range.last < range.first)
+                        return RangeResult::Ignore;
+
+                    if (range.first >= length)
+                        continue;
+                    if (range.last >= length)
+                        range.last = length - 1;
+                }
+
+                ranges.push_back(range);
+            }
+
+            if (count == 0)
+                return RangeResult::Ignore;
+            if (ranges.empty())
+                return RangeResult::Unsatisfiable;
+
+            std::sort(ranges.begin(), ranges.end(), [](const ByteRange& a, const ByteRange& b) { return a.first < b.first; });
+
+            std::size_t merged = 0;
+            for (std::size_t i = 1; i < ranges.size(); ++i)
+            {
+                if (ranges[i].first <= ranges[merged].last + 1)
+                    ranges[merged].last = std::max(ranges[merged].last, ranges[i].last);
+                else
+                    ranges[++merged] = ranges[i];
+            }
+            ranges.resize(merged + 1);
+
+            return RangeResult::Satisfiable;
+        }
+    } // Namespace http
+} // Namespace primus
+
+#endif // PRIMUSRANGE_HPP
@@ -0,0 +1,243 @@
+#include "AttendanceIndex.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <climits>
+
+#include "general/date.hpp"
+
+using DayBitmap       = primus::managers::Attendance::DayBitmap;
+using AttendanceIndex = primus::managers::Attendance::AttendanceIndex;
+using AttendanceDto   = primus::dto::database::AttendanceDto;
+
+namespace {
+    /**
+     * @brief Index of the block containing a day. Rounds towards negative infinity, days before 1970 belong to negative blocks.
+     */
+    int blockOf(int day)
+    {
+        return day >= 0 ? day / 64 : -((-day - 1) / 64) - 1;
+    }
+
+    /**
+     * @brief Mask selecting the days from first to last (both included) of the block starting at blockStart.
+     */
+    v_uint64 maskOf(int blockStart, int first, int last)
+    {
+        const int from = std::max(first, blockStart) - blockStart;
+        const int to = std::min(last, blockStart + 63) - blockStart;
+
+        const v_uint64 upper = to == 63 ? ~v_uint64(0) : (v_uint64(1) << (to + 1)) - 1;
+        return upper & ~((v_uint64(1) << from) - 1);
+    }
+
+    v_uint32 popcount(v_uint64 bits)
+    {
+        return static_cast<v_uint32>(std::bitset<64>(bits).count());
+    }
+}
+
+bool DayBitmap::set(int day)
+{
+    const int index = blockOf(day);
+    const v_uint64 bit = v_uint64(1) << (day - index * 64);
+
+    auto it = std::lower_bound(m_blocks.begin(), m_blocks.end(), index, [](const Block& block, int value) { return block.index < value; });
+    if (it == m_blocks.end() || it->index != index)
+    {
+        m_blocks.insert(it, Block{ index, bit });
+        return true;
+    }
+
+    if (it->bits & bit)
+        return false;
+
+    it->bits |= bit;
+    return true;
+}
+
+bool DayBitmap::clear(int day)
+{
+    const int index = blockOf(day);
+    const v_uint64 bit = v_uint64(1) << (day - index * 64);
+
+    auto it = std::lower_bound(m_blocks.begin(), m_blocks.end(), index, [](const Block& block, int value) { return block.index < value; });
+    if (it == m_blocks.end() || it->index != index || (it->bits & bit) == 0)
+        return false;
+
+    it->bits &= ~bit;
+    if (it->bits == 0)
+        m_blocks.erase(it);
+
+    return true;
+}
+
+bool DayBitmap::test(int day) const
+{
+    return count(day, day) != 0;
+}
+
+v_uint32 DayBitmap::count(int first, int last) const
+{
+    if (first > last)
+        return 0;
+
+    v_uint32 days = 0;
+    const int lastIndex = blockOf(last);
+
+    auto it = std::lower_bound(m_blocks.begin(), m_blocks.end(), blockOf(first), [](const Block& block, int value) { return block.index < value; });
+    for (; it != m_blocks.end() && it->index <= lastIndex; ++it)
+        days += popcount(it->bits & maskOf(it->index * 64, first, last));
+
+    return days;
+}
+
+v_uint32 DayBitmap::size(void) const
+{
+    v_uint32 days = 0;
+    for (const Block& block : m_blocks)
+        days += popcount(block.bits);
+
+    return days;
+}
+
+v_uint32 DayBitmap::months(int first, int last) const
+{
+    static const v_uint32 allMonths = (1u << 12) - 1;
+
+    if (first > last)
+        return 0;
+
+    v_uint32 found = 0;
+    const int lastIndex = blockOf(last);
+
+    auto it = std::lower_bound(m_blocks.begin(), m_blocks.end(), blockOf(first), [](const Block& block, int value) { return block.index < value; });
+    for (; it != m_blocks.end() && it->index <= lastIndex && found != allMonths; ++it)
+    {
+        const int blockStart = it->index * 64;
+        int start = std::max(first, blockStart);
+        const int end = std::min(last, blockStart + 63);
+
+        // A block covers at most three months, test the days of each of them at once
+        while (start <= end)
+        {
+            int year, month, day;
+            primus::date::civilFromDays(start, year, month, day);
+
+            const int nextMonth = month == 12 ? primus::date::daysFromCivil(year + 1, 1, 1) : primus::date::daysFromCivil(year, month + 1, 1);
+            if (it->bits & maskOf(blockStart, start, std::min(end, nextMonth - 1)))
+                found |= 1u << (month - 1);
+
+            start = nextMonth;
+        }
+    }
+
+    return found;
+}
+
+AttendanceIndex::AttendanceIndex(void)
+{
+    load();
+}
+
+std::shared_ptr<AttendanceIndex> AttendanceIndex::createShared(void)
+{
+    return std::shared_ptr<AttendanceIndex>(new AttendanceIndex());
+}
+
+void AttendanceIndex::addAttendance(v_uint32 memberId, const std::string& date)
+{
+    int day;
+    if (!primus::date::parseDay(date, day))
+        return;
+
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_members[memberId].set(day);
+}
+
+void AttendanceIndex::removeAttendance(v_uint32 memberId, const std::string& date)
+{
+    int day;
+    if (!primus::date::parseDay(date, day))
+        return;
+
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    auto it = m_members.find(memberId);
+    if (it == m_members.end())
+        return;
+
+    it->second.clear(day);
+    if (it->second.empty())
+        m_members.erase(it);
+}
+
+bool AttendanceIndex::hasAttended(v_uint32 memberId, const std::string& date)
+{
+    int day;
+    if (!primus::date::parseDay(date, day))
+        return false;
+
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    auto it = m_members.find(memberId);
+    return it != m_members.end() && it->second.test(day);
+}
+
+v_uint32 AttendanceIndex::count(v_uint32 memberId)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    auto it = m_members.find(memberId);
+    return it != m_members.end() ? it->second.size() : 0;
+}
+
+v_uint32 AttendanceIndex::countSince(v_uint32 memberId, int first)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    auto it = m_members.find(memberId);
+    return it != m_members.end() ? it->second.count(first, INT_MAX) : 0;
+}
+
+v_uint32 AttendanceIndex::countMonthsSince(v_uint32 memberId, int first)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    auto it = m_members.find(memberId);
+    return it != m_members.end() ? popcount(it->second.months(first, INT_MAX)) : 0;
+}
+
+bool AttendanceIndex::load(void)
+{
+    auto dbResult = m_database->getAllAttendances();
+    if (!dbResult->isSuccess())
+    {
+        OATPP_LOGE(logName, "Failed to load the attendances: %s", dbResult->getErrorMessage()->c_str());
+        return false;
+    }
+
+    auto attendances = dbResult->fetch<oatpp::Vector<oatpp::Object<AttendanceDto>>>();
+
+    std::map<v_uint32, DayBitmap> members;
+    v_uint32 skipped = 0;
+
+    for (const auto& attendance : *attendances)
+    {
+        int day;
+        if (attendance->date && primus::date::parseDay(*attendance->date, day))
+            members[attendance->memberId].set(day);
+        else
+            ++skipped;
+    }
+
+    if (skipped > 0)
+        OATPP_LOGW(logName, "Skipped %d attendances without a date in the format YYYY-MM-DD", static_cast<int>(skipped));
+
+    OATPP_LOGI(logName, "Loaded %d attendances of %d members", static_cast<int>(attendances->size() - skipped), static_cast<int>(members.size()));
+
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_members.swap(members);
+
+    return true;
+}
@@ -0,0 +1,170 @@
+#ifndef ATTENDANCE_INDEX_HPP
+#define ATTENDANCE_INDEX_HPP
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <memory>
+
+#include "oatpp/core/Types.hpp"
+#include "oatpp/core/macro/component.hpp"
+#include "database/DatabaseClient.hpp"
+
+#include "general/constants.hpp"
+
+namespace primus {
+    namespace managers {
+        namespace Attendance {
+
+            /**
+             * @brief Set of days stored as bitmap. Only blocks of 64 days containing at least one day are stored.
+             * Days are counted since 1970-01-01, see primus::date::daysFromCivil.
+             */
+            class DayBitmap
+            {
+                /**
+                 * @brief 64 consecutive days, starting at day index * 64.
+                 */
+                struct Block
+                {
+                    int         index;
+                    v_uint64    bits;
+                };
+
+            private:
+                std::vector<Block> m_blocks; // Sorted by index
+
+            public:
+                /**
+                 * @brief Adds a day.
+                 * @return True if the day was not part of the set before.
+                 */
+                bool set(int day);
+
+                /**
+                 * @brief Removes a day.
+                 * @return True if the day was part of the set.
+                 */
+                bool clear(int day);
+
+                /**
+                 * @brief Checks whether a day is part of the set.
+                 */
+                bool test(int day) const;
+
+                /**
+                 * @brief Counts the days from first to last, both included.
+                 */
+                v_uint32 count(int first, int last) const;
+
+                /**
+                 * @brief Counts all days of the set.
+                 */
+                v_uint32 size(void) const;
+
+                /**
+                 * @brief Collects the months of the days from first to last, both included.
+                 * @return Bit n - 1 is set if there is a day in month n, no matter of which year.
+                 */
+                v_uint32 months(int first, int last) const;
+
+                /**
+                 * @brief Checks whether the set is empty.
+                 */
+                bool empty(void) const
+                {
+                    return m_blocks.empty();
+                }
+            };
+
+            /**
+             * @brief In-memory index of all attendances, one DayBitmap per member.
+             * It is loaded once and updated as attendances are set and deleted, so attendance checks never touch the database.
+             */
+            class AttendanceIndex
+            {
+                static constexpr const char* logName = primus::constants::managers::manager_attendance::logName;
+
+            private:
+                OATPP_COMPONENT(std::shared_ptr<primus::component::DatabaseClient>, m_database);
+
+                std::map<v_uint32, DayBitmap>   m_members;
+                std::mutex                      m_lock;
+
+            private:
+                /**
+                 * @brief Constructor for the AttendanceIndex class. Loads all attendances.
+                 */
+                AttendanceIndex(void);
+
+            public:
+                /**
+                 * @brief Destructor for the AttendanceIndex class.
+                 */
+                virtual ~AttendanceIndex(void) = default;
+
+                /**
+                 * @brief Creates a shared pointer to an AttendanceIndex instance.
+                 * @return Shared pointer to the AttendanceIndex instance.
+                 */
+                static std::shared_ptr<AttendanceIndex> createShared(void);
+
+                /**
+                 * @brief Adds an attendance which was stored in the database.
+                 * @param memberId ID of the member.
+                 * @param date Date of the attendance (format: YYYY-MM-DD). Other formats are ignored.
+                 */
+                void addAttendance(v_uint32 memberId, const std::string& date);
+
+                /**
+                 * @brief Removes an attendance which was deleted from the database.
+                 * @param memberId ID of the member.
+                 * @param date Date of the attendance (format: YYYY-MM-DD).
+                 */
+                void removeAttendance(v_uint32 memberId, const std::string& date);
+
+                /**
+                 * @brief Checks whether a member attended on a date.
+                 * @param memberId ID of the member.
+                 * @param date Date of the attendance (format: YYYY-MM-DD).
+                 * @return True if the member attended.
+                 */
+                bool hasAttended(v_uint32 memberId, const std::string& date);
+
+                /**
+                 * @brief Counts all attendances of a member.
+                 * @param memberId ID of the member.
+                 * @return Count of attendances.
+                 */
+                v_uint32 count(v_uint32 memberId);
+
+                /**
+                 * @brief Counts the attendances of a member on or after a day.
+                 * @param memberId ID of the member.
+                 * @param first First day to count, in days since 1970-01-01.
+                 * @return Count of attendances.
+                 */
+                v_uint32 countSince(v_uint32 memberId, int first);
+
+                /**
+                 * @brief Counts the distinct months of the year (1 to 12) a member attended in on or after a day.
+                 * @param memberId ID of the member.
+                 * @param first First day to consider, in days since 1970-01-01.
+                 * @return Count of months, 0 to 12.
+                 */
+                v_uint32 countMonthsSince(v_uint32 memberId, int first);
+
+            private:
+                /**
+                 * @brief Replaces the index with the attendances stored in the database.
+                 * @return True if the attendances were loaded.
+                 */
+                bool load(void);
+            };
+
+        } // namespace Attendance
+    } // namespace managers
+} // namespace primus
+
+#endif // ATTENDANCE_INDEX_HPP
@@ -0,0 +1,172 @@
+#include "AvatarManager.hpp"
+
+#include <cstring>
+
+#include "filesystemHelper.hpp"
+
+using AvatarManager = primus::managers::Avatar::AvatarManager;
+using StaticManager = primus::managers::Static::StaticManager;
+using StaticAsset   = primus::managers::Static::StaticAsset;
+
+AvatarManager::AvatarManager(const std::string& directory)
+    : m_directory(directory)
+    , m_defaults(loadDefaults())
+    , m_uploadCounter(0)
+{
+}
+
+std::shared_ptr<AvatarManager> AvatarManager::createShared(const std::string& directory)
+{
+    return std::shared_ptr<AvatarManager>(new AvatarManager(directory));
+}
+
+std::shared_ptr<const StaticAsset> AvatarManager::getAvatar(v_uint32 memberId)
+{
+    const auto now = std::chrono::steady_clock::now();
+
+    CacheEntry cached;
+
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+
+        auto it = m_avatars.find(memberId);
+        if (it != m_avatars.end())
+        {
+            if (now - it->second.checked < std::chrono::seconds(primus::constants::managers::manager_static::revalidateSeconds))
+                return it->second.asset;
+
+            it->second.checked = now;
+            cached = it->second;
+        }
+    }
+
+    if (cached.asset)
+    {
+        primus::component::filesystem::FileInfo info;
+        bool unchanged = true;
+
+        // Still the same picture, or still no picture of its own
+        if (cached.custom)
+        {
+            unchanged = primus::component::filesystem::getFileInfo(cached.asset->filePath, info)
+                && info.modified == cached.asset->modified && info.size == cached.asset->contentLength;
+        }
+        else
+        {
+            for (const char* extension : primus::constants::managers::manager_avatar::extensions)
+                unchanged = unchanged && !primus::component::filesystem::getFileInfo(getAvatarPath(memberId, extension), info);
+        }
+
+        if (unchanged)
+            return cached.asset;
+
+        OATPP_LOGI(logName, "Picture of member %u changed on disk. Resolving again", memberId);
+    }
+
+    CacheEntry entry = resolve(memberId, now);
+
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    if (entry.asset)
+        m_avatars[memberId] = entry;
+    else
+        m_avatars.erase(memberId);
+
+    return entry.asset;
+}
+
+std::shared_ptr<const StaticAsset> AvatarManager::getDefaultAvatar(v_uint32 memberId)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    // Members without a picture always get the same default picture, so browsers can cache it
+    if (m_defaults.empty())
+        return nullptr;
+
+    return m_defaults[memberId % m_defaults.size()];
+}
+
+void AvatarManager::invalidate(v_uint32 memberId)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_avatars.erase(memberId);
+}
+
+void AvatarManager::invalidateAll(void)
+{
+    std::vector<Asset> defaults = loadDefaults();
+
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_avatars.clear();
+    m_defaults.swap(defaults);
+}
+
+std::string AvatarManager::getAvatarPath(v_uint32 memberId, const char* extension) const
+{
+    return m_directory + "/" + std::to_string(memberId) + "." + extension;
+}
+
+std::string AvatarManager::getTemporaryPath(v_uint32 memberId)
+{
+    return m_directory + "/" + std::to_string(memberId) + ".upload-" + std::to_string(++m_uploadCounter);
+}
+
+std::string AvatarManager::storeAvatar(v_uint32 memberId, const std::string& temporaryPath, const char* extension)
+{
+    const std::string path = getAvatarPath(memberId, extension);
+
+    if (!primus::component::filesystem::replaceFile(temporaryPath, path))
+    {
+        OATPP_LOGE(logName, "Failed to move %s to %s", temporaryPath.c_str(), path.c_str());
+        return "";
+    }
+
+    // A picture in another format would shadow or be shadowed by the new one
+    for (const char* other : primus::constants::managers::manager_avatar::extensions)
+    {
+        if (std::strcmp(other, extension) != 0)
+            primus::component::filesystem::removeFile(getAvatarPath(memberId, other));
+    }
+
+    invalidate(memberId);
+
+    OATPP_LOGI(logName, "Stored new picture of member %u at %s", memberId, path.c_str());
+    return path;
+}
+
+AvatarManager::CacheEntry AvatarManager::resolve(v_uint32 memberId, std::chrono::steady_clock::time_point now)
+{
+    Asset asset;
+
+    for (const char* extension : primus::constants::managers::manager_avatar::extensions)
+    {
+        asset = StaticManager::loadAsset(getAvatarPath(memberId, extension));
+        if (asset)
+            return CacheEntry{ asset, true, now };
+    }
+
+    asset = getDefaultAvatar(memberId);
+    if (!asset)
+        OATPP_LOGE(logName, "No picture for member %u and no default picture found in %s", memberId, m_directory.c_str());
+
+    return CacheEntry{ asset, false, now };
+}
+
+std::vector<std::shared_ptr<const StaticAsset>> AvatarManager::loadDefaults(void) const
+{
+    std::vector<Asset> defaults;
+
+    for (const char* name : primus::constants::managers::manager_avatar::defaultAvatars)
+    {
+        Asset asset = StaticManager::loadAsset(m_directory + "/" + name);
+        if (!asset)
+        {
+            OATPP_LOGE(logName, "Default picture %s not found in %s", name, m_directory.c_str());
+            continue;
+        }
+
+        defaults.push_back(asset);
+    }
+
+    return defaults;
+}
@@ -0,0 +1,143 @@
+#ifndef AVATAR_MANAGER_HPP
+#define AVATAR_MANAGER_HPP
+
+#include <map>
+#include <mutex>
+#include <chrono>
+#include <string>
+#include <memory>
+#include <vector>
+#include <atomic>
+
+#include "oatpp/core/Types.hpp"
+
+#include "general/constants.hpp"
+#include "managers/StaticManager.hpp"
+
+namespace primus {
+    namespace managers {
+        namespace Avatar {
+
+            /**
+             * @brief Resolves and caches the profile pictures of members.
+             * Each member is mapped to its own picture or, if it has none, to one of the default pictures.
+             * Both outcomes are cached, so serving a picture needs neither the database nor more than one file system check every few seconds.
+             */
+            class AvatarManager
+            {
+                using Asset = std::shared_ptr<const primus::managers::Static::StaticAsset>;
+
+                static constexpr const char* logName = primus::constants::managers::manager_avatar::logName;
+
+                /**
+                 * @brief Cache entry of a single member.
+                 */
+                struct CacheEntry
+                {
+                    Asset                                   asset;   /**< Resolved picture. */
+                    bool                                    custom;  /**< False if the member has no picture of its own and a default picture is served. */
+                    std::chrono::steady_clock::time_point   checked; /**< Last time the file system was checked for changes. */
+                };
+
+            private:
+                const std::string               m_directory;
+                std::vector<Asset>              m_defaults;
+                std::map<v_uint32, CacheEntry>  m_avatars;
+                std::mutex                      m_lock;
+                std::atomic<v_uint32>           m_uploadCounter;
+
+            private:
+                /**
+                 * @brief Constructor for the AvatarManager class. Loads the default pictures.
+                 * @param directory Directory holding the pictures of the members.
+                 */
+                explicit AvatarManager(const std::string& directory);
+
+            public:
+                /**
+                 * @brief Destructor for the AvatarManager class.
+                 */
+                virtual ~AvatarManager(void) = default;
+
+                /**
+                 * @brief Creates a shared pointer to an AvatarManager instance.
+                 * @param directory Directory holding the pictures of the members.
+                 * @return Shared pointer to the AvatarManager instance.
+                 */
+                static std::shared_ptr<AvatarManager> createShared(const std::string& directory);
+
+                /**
+                 * @brief Retrieves the profile picture of a member.
+                 * Members without a picture of their own always get the same default picture.
+                 * Every member requested here keeps an entry in the cache, so only members which exist may be requested.
+                 * Other ids have to use getDefaultAvatar.
+                 * @param memberId ID of an existing member.
+                 * @return The picture or nullptr if neither the picture of the member nor a default picture exists.
+                 */
+                Asset getAvatar(v_uint32 memberId);
+
+                /**
+                 * @brief Retrieves the default picture of a member without caching it, e.g. for ids which do not exist.
+                 * @param memberId ID of the member, selects one of the default pictures.
+                 * @return The picture or nullptr if no default picture exists.
+                 */
+                Asset getDefaultAvatar(v_uint32 memberId);
+
+                /**
+                 * @brief Drops the cached picture of a member, e.g. after the member was created or its picture changed.
+                 * @param memberId ID of the member.
+                 */
+                void invalidate(v_uint32 memberId);
+
+                /**
+                 * @brief Drops all cached pictures and loads the default pictures again.
+                 */
+                void invalidateAll(void);
+
+                /**
+                 * @brief Builds the path of the picture of a member.
+                 * @param memberId ID of the member.
+                 * @param extension File extension matching the format of the picture.
+                 * @return Path of the file, whether it exists or not.
+                 */
+                std::string getAvatarPath(v_uint32 memberId, const char* extension) const;
+
+                /**
+                 * @brief Creates a unique path for receiving a new picture of a member.
+                 * The path is located in the picture directory, so the finished file can be moved into place without copying.
+                 * @param memberId ID of the member.
+                 * @return Path of the temporary file.
+                 */
+                std::string getTemporaryPath(v_uint32 memberId);
+
+                /**
+                 * @brief Replaces the picture of a member with a completely written file.
+                 * The file is moved into place in one step and pictures of the member in other formats are deleted.
+                 * @param memberId ID of the member.
+                 * @param temporaryPath Path of the new picture. Has to be in the same directory.
+                 * @param extension File extension matching the format of the new picture.
+                 * @return Path of the stored picture or an empty string if it could not be moved into place.
+                 */
+                std::string storeAvatar(v_uint32 memberId, const std::string& temporaryPath, const char* extension);
+
+            private:
+                /**
+                 * @brief Resolves the picture of a member from disk.
+                 * @param memberId ID of the member.
+                 * @param now Time of the resolution.
+                 * @return The new cache entry.
+                 */
+                CacheEntry resolve(v_uint32 memberId, std::chrono::steady_clock::time_point now);
+
+                /**
+                 * @brief Loads the default pictures.
+                 * @return The loaded pictures. Missing ones are left out.
+                 */
+                std::vector<Asset> loadDefaults(void) const;
+            };
+
+        } // namespace Avatar
+    } // namespace managers
+} // namespace primus
+
+#endif // AVATAR_MANAGER_HPP
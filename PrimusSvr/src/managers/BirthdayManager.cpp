@@ -0,0 +1,111 @@
+#include "BirthdayManager.hpp"
+
+#include <algorithm>
+
+using BirthdayManager = primus::managers::Birthday::BirthdayManager;
+using BirthdayDto     = primus::dto::database::BirthdayDto;
+
+BirthdayManager::BirthdayManager(void)
+{
+    load();
+}
+
+std::shared_ptr<BirthdayManager> BirthdayManager::createShared(void)
+{
+    return std::shared_ptr<BirthdayManager>(new BirthdayManager());
+}
+
+std::vector<v_uint32> BirthdayManager::getNext(const std::string& day, v_uint32 limit, v_uint32 offset)
+{
+    std::vector<v_uint32> memberIds;
+
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    if (offset >= m_ring.size())
+        return memberIds;
+
+    // First birthday on or after the day, wrapping around to the start of the year
+    auto it = m_ring.lower_bound(Entry(day, 0));
+    for (v_uint32 skipped = 0; skipped < offset; ++skipped)
+    {
+        if (it == m_ring.end())
+            it = m_ring.begin();
+        ++it;
+    }
+
+    const std::size_t count = std::min<std::size_t>(limit, m_ring.size() - offset);
+    memberIds.reserve(count);
+
+    while (memberIds.size() < count)
+    {
+        if (it == m_ring.end())
+            it = m_ring.begin();
+
+        memberIds.push_back(it->second);
+        ++it;
+    }
+
+    return memberIds;
+}
+
+v_uint32 BirthdayManager::getSize(void)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    return static_cast<v_uint32>(m_ring.size());
+}
+
+void BirthdayManager::refresh(v_uint32 memberId)
+{
+    auto dbResult = m_database->getActiveMemberBirthday(memberId);
+    if (!dbResult->isSuccess())
+    {
+        OATPP_LOGE(logName, "Failed to read the birthday of member %d: %s", memberId, dbResult->getErrorMessage()->c_str());
+        return;
+    }
+
+    auto birthdays = dbResult->fetch<oatpp::Vector<oatpp::Object<BirthdayDto>>>();
+
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    auto it = m_days.find(memberId);
+    if (it != m_days.end())
+    {
+        m_ring.erase(Entry(it->second, memberId));
+        m_days.erase(it);
+    }
+
+    // Inactive members and members without a valid birth date are not part of the calendar
+    if (birthdays->empty())
+        return;
+
+    const std::string& day = *birthdays[0]->day;
+    m_ring.insert(Entry(day, memberId));
+    m_days[memberId] = day;
+}
+
+bool BirthdayManager::load(void)
+{
+    auto dbResult = m_database->getActiveMemberBirthdays();
+    if (!dbResult->isSuccess())
+    {
+        OATPP_LOGE(logName, "Failed to load the birthdays: %s", dbResult->getErrorMessage()->c_str());
+        return false;
+    }
+
+    auto birthdays = dbResult->fetch<oatpp::Vector<oatpp::Object<BirthdayDto>>>();
+
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    m_ring.clear();
+    m_days.clear();
+
+    // The rows are sorted already, every insert goes to the end of the ring
+    for (const auto& birthday : *birthdays)
+    {
+        m_ring.insert(m_ring.end(), Entry(*birthday->day, birthday->memberId));
+        m_days[birthday->memberId] = *birthday->day;
+    }
+
+    OATPP_LOGI(logName, "Loaded the birthdays of %d members", static_cast<int>(m_ring.size()));
+    return true;
+}
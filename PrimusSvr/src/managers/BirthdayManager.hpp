@@ -0,0 +1,93 @@
+#ifndef BIRTHDAY_MANAGER_HPP
+#define BIRTHDAY_MANAGER_HPP
+
+#include <map>
+#include <set>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include <memory>
+
+#include "oatpp/core/Types.hpp"
+#include "oatpp/core/macro/component.hpp"
+#include "database/DatabaseClient.hpp"
+
+#include "general/constants.hpp"
+
+namespace primus {
+    namespace managers {
+        namespace Birthday {
+
+            /**
+             * @brief Calendar of the birthdays of all active members.
+             * The birthdays are kept in memory as a ring ordered by day (MM-DD) and id. The next birthdays of a day are found
+             * with a single seek, followed by a scan of the requested entries which continues at 01-01 after 12-31.
+             */
+            class BirthdayManager
+            {
+                static constexpr const char* logName = primus::constants::managers::manager_birthday::logName;
+
+                using Entry = std::pair<std::string, v_uint32>; // Day of the birthday and id of the member
+
+            private:
+                OATPP_COMPONENT(std::shared_ptr<primus::component::DatabaseClient>, m_database);
+
+                std::set<Entry>                 m_ring;
+                std::map<v_uint32, std::string> m_days;     // Day of the birthday per member in the ring
+                std::mutex                      m_lock;
+
+            private:
+                /**
+                 * @brief Constructor for the BirthdayManager class. Loads the birthdays.
+                 */
+                BirthdayManager(void);
+
+            public:
+                /**
+                 * @brief Destructor for the BirthdayManager class.
+                 */
+                virtual ~BirthdayManager(void) = default;
+
+                /**
+                 * @brief Creates a shared pointer to a BirthdayManager instance.
+                 * @return Shared pointer to the BirthdayManager instance.
+                 */
+                static std::shared_ptr<BirthdayManager> createShared(void);
+
+                /**
+                 * @brief Retrieves the members with the next birthdays, starting with the birthdays on the given day.
+                 * Every member is returned at most once, no matter how far the page reaches.
+                 * @param day First day to consider (format: MM-DD).
+                 * @param limit Maximum count of members to return.
+                 * @param offset Count of birthdays to skip.
+                 * @return Ids of the members in the order of their next birthday.
+                 */
+                std::vector<v_uint32> getNext(const std::string& day, v_uint32 limit, v_uint32 offset);
+
+                /**
+                 * @brief Retrieves the count of members in the calendar, i.e. active members with a valid birth date.
+                 * @return Count of members in the calendar.
+                 */
+                v_uint32 getSize(void);
+
+                /**
+                 * @brief Reads the birthday of a member from the database again, e.g. after the member was created, updated,
+                 * activated or deactivated.
+                 * @param memberId ID of the member.
+                 */
+                void refresh(v_uint32 memberId);
+
+            private:
+                /**
+                 * @brief Replaces the calendar with the birthdays stored in the database.
+                 * @return True if the birthdays were loaded.
+                 */
+                bool load(void);
+            };
+
+        } // namespace Birthday
+    } // namespace managers
+} // namespace primus
+
+#endif // BIRTHDAY_MANAGER_HPP
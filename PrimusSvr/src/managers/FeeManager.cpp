@@ -0,0 +1,132 @@
+#include "FeeManager.hpp"
+
+using FeeManager   = primus::managers::Fee::FeeManager;
+using FeeTotals    = primus::managers::Fee::FeeTotals;
+using MemberFeeDto = primus::dto::MemberFeeDto;
+
+namespace {
+    // The department values may be changed later on, as we may implement functionality to create new departments
+    constexpr v_uint32 departmentBow     = 1;
+    constexpr v_uint32 departmentAirgun  = 2;
+    constexpr v_uint32 departmentFirearm = 3;
+
+    enum DepartmentPrices
+    {
+        Bogenschiessen = 8,
+        Luftdruck = 10,
+        Schusswaffen = 15,
+        Multiple = 20,
+        None = 0
+    };
+}
+
+std::shared_ptr<FeeManager> FeeManager::createShared(void)
+{
+    return std::shared_ptr<FeeManager>(new FeeManager());
+}
+
+oatpp::Vector<FeeManager::ObjMemberFeeDto> FeeManager::getActiveMemberFees(v_uint32 afterId, v_uint32 limit)
+{
+    auto dbResult = m_database->getActiveMemberFeesAfter(afterId, limit);
+    PRIMUS_ASSERT_HTTP(dbResult->isSuccess(), 500, "Database request error", dbResult->getErrorMessage());
+
+    auto fees = dbResult->fetch<oatpp::Vector<ObjMemberFeeDto>>();
+
+    for (auto& memberFee : *fees)
+    {
+        const v_uint32 departments = memberFee->departments;
+
+        memberFee->fee = FeeManager::calculateFee(departments, departments == 1 ? memberFee->departmentId.operator v_uint32() : 0);
+
+        // The grouped query returns one of the departments, it only identifies the department if there is exactly one
+        if (departments != 1)
+        {
+            memberFee->departmentId = nullptr;
+            memberFee->department = nullptr;
+        }
+    }
+
+    OATPP_LOGD(logName, "Calculated the fees of %d members after id %d", static_cast<int>(fees->size()), afterId);
+
+    return fees;
+}
+
+FeeManager::UInt32 FeeManager::calculateFee(v_uint32 departmentCount, v_uint32 departmentId)
+{
+    if (departmentCount < 1) // No department
+        return static_cast<v_uint32>(DepartmentPrices::None);
+
+    if (departmentCount > 1) // multiple departments
+        return static_cast<v_uint32>(DepartmentPrices::Multiple);
+
+    switch (departmentId) // Only one department
+    {
+    case departmentBow:
+        return static_cast<v_uint32>(DepartmentPrices::Bogenschiessen);
+    case departmentAirgun:
+        return static_cast<v_uint32>(DepartmentPrices::Luftdruck);
+    case departmentFirearm:
+        return static_cast<v_uint32>(DepartmentPrices::Schusswaffen);
+    }
+
+    return nullptr;
+}
+
+FeeTotals::FeeTotals(void)
+    : m_multiple(createTotal(nullptr, "Multiple"))
+    , m_none(createTotal(nullptr, "None"))
+{}
+
+void FeeTotals::add(const oatpp::Object<MemberFeeDto>& memberFee)
+{
+    ObjFeeTotalDto total;
+
+    if (memberFee->departments == 0)
+        total = m_none;
+    else if (memberFee->departments > 1)
+        total = m_multiple;
+    else
+    {
+        auto it = m_departments.find(memberFee->departmentId.operator v_uint32());
+        if (it == m_departments.end())
+            it = m_departments.insert(std::make_pair(memberFee->departmentId.operator v_uint32(), createTotal(memberFee->departmentId, memberFee->department))).first;
+
+        total = it->second;
+    }
+
+    total->members = *total->members + 1;
+    if (memberFee->fee != nullptr)
+        total->amount = *total->amount + *memberFee->fee;
+}
+
+oatpp::Object<FeeTotals::FeeTotalsDto> FeeTotals::get(void) const
+{
+    auto totals = FeeTotalsDto::createShared();
+    totals->departments = oatpp::Vector<ObjFeeTotalDto>::createShared();
+    totals->members = static_cast<v_uint32>(0);
+    totals->amount = static_cast<v_uint32>(0);
+
+    for (const auto& department : m_departments)
+        totals->departments->push_back(department.second);
+
+    totals->departments->push_back(m_multiple);
+    totals->departments->push_back(m_none);
+
+    for (const auto& total : *totals->departments)
+    {
+        totals->members = *totals->members + *total->members;
+        totals->amount = *totals->amount + *total->amount;
+    }
+
+    return totals;
+}
+
+FeeTotals::ObjFeeTotalDto FeeTotals::createTotal(const oatpp::UInt32& departmentId, const oatpp::String& department)
+{
+    auto total = FeeTotalDto::createShared();
+    total->departmentId = departmentId;
+    total->department = department;
+    total->members = static_cast<v_uint32>(0);
+    total->amount = static_cast<v_uint32>(0);
+    return total;
+}
@@ -0,0 +1,110 @@
+#ifndef FEE_MANAGER_HPP
+#define FEE_MANAGER_HPP
+
+#include <map>
+#include <memory>
+
+#include "oatpp/core/Types.hpp"
+#include "oatpp/core/macro/component.hpp"
+#include "database/DatabaseClient.hpp"
+
+#include "general/constants.hpp"
+#include "general/exceptions.hpp"
+#include "dto/FeeDto.hpp"
+
+namespace primus {
+    namespace managers {
+        namespace Fee {
+
+            /**
+             * @brief Calculates the membership fees.
+             * The fees of many members are calculated from one grouped query over their departments, instead of reading
+             * the departments of every member on their own.
+             */
+            class FeeManager
+            {
+                using UInt32 = oatpp::UInt32;
+
+                using MemberFeeDto = primus::dto::MemberFeeDto;
+                using ObjMemberFeeDto = oatpp::Object<MemberFeeDto>;
+
+                static constexpr const char* logName = primus::constants::managers::manager_fee::logName;
+
+            private:
+                OATPP_COMPONENT(std::shared_ptr<primus::component::DatabaseClient>, m_database);
+
+            private:
+                /**
+                 * @brief Default constructor for the FeeManager class.
+                 */
+                FeeManager(void) = default;
+
+            public:
+                /**
+                 * @brief Destructor for the FeeManager class.
+                 */
+                virtual ~FeeManager(void) = default;
+
+                /**
+                 * @brief Creates a shared pointer to a FeeManager instance.
+                 * @return Shared pointer to the FeeManager instance.
+                 */
+                static std::shared_ptr<FeeManager> createShared(void);
+
+                /**
+                 * @brief Retrieves the fees of a page of active members with a single query.
+                 * @param afterId Only members with a greater ID are returned. 0 to start with the first member.
+                 * @param limit Maximum count of members.
+                 * @return The fees sorted by ID. Fewer than limit if there are no more members.
+                 */
+                oatpp::Vector<ObjMemberFeeDto> getActiveMemberFees(v_uint32 afterId, v_uint32 limit);
+
+                /**
+                 * @brief Calculates the membership fee based on the departments of a member.
+                 * @param departmentCount The count of departments of the member.
+                 * @param departmentId The ID of the department, only used if the member is in exactly one department.
+                 * @return The fee in euro. Null if the only department of the member has no fee.
+                 */
+                static UInt32 calculateFee(v_uint32 departmentCount, v_uint32 departmentId);
+            };
+
+            /**
+             * @brief Sums up the fees of a report while its pages are read.
+             * Members in exactly one department are summed per department, the others as Multiple and None.
+             */
+            class FeeTotals
+            {
+                using FeeTotalDto = primus::dto::FeeTotalDto;
+                using FeeTotalsDto = primus::dto::FeeTotalsDto;
+                using ObjFeeTotalDto = oatpp::Object<FeeTotalDto>;
+
+            private:
+                std::map<v_uint32, ObjFeeTotalDto>  m_departments;  // Members in exactly one department, by the ID of the department
+                ObjFeeTotalDto                      m_multiple;
+                ObjFeeTotalDto                      m_none;
+
+            public:
+                /**
+                 * @brief Constructor for the FeeTotals class.
+                 */
+                FeeTotals(void);
+
+                /**
+                 * @brief Adds the fee of a member.
+                 */
+                void add(const oatpp::Object<primus::dto::MemberFeeDto>& memberFee);
+
+                /**
+                 * @brief Retrieves the totals of all members added so far.
+                 */
+                oatpp::Object<FeeTotalsDto> get(void) const;
+
+            private:
+                static ObjFeeTotalDto createTotal(const oatpp::UInt32& departmentId, const oatpp::String& department);
+            };
+
+        } // namespace Fee
+    } // namespace managers
+} // namespace primus
+
+#endif // FEE_MANAGER_HPP
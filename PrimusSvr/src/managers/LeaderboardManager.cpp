@@ -0,0 +1,193 @@
+#include "LeaderboardManager.hpp"
+
+#include <chrono>
+#include <ctime>
+#include <iterator>
+
+using LeaderboardManager = primus::managers::Leaderboard::LeaderboardManager;
+
+LeaderboardManager::LeaderboardManager(void)
+    : m_stop(false)
+{
+    load();
+    m_sweeper = std::thread(&LeaderboardManager::run, this);
+}
+
+LeaderboardManager::~LeaderboardManager(void)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_stop = true;
+    }
+
+    m_wakeup.notify_all();
+    m_sweeper.join();
+}
+
+std::shared_ptr<LeaderboardManager> LeaderboardManager::createShared(void)
+{
+    return std::shared_ptr<LeaderboardManager>(new LeaderboardManager());
+}
+
+std::vector<v_uint32> LeaderboardManager::getPage(v_uint32 limit, v_uint32 offset)
+{
+    std::vector<v_uint32> memberIds;
+
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    if (offset >= m_ranking.size())
+        return memberIds;
+
+    auto it = m_ranking.begin();
+    std::advance(it, offset);
+
+    for (; it != m_ranking.end() && memberIds.size() < limit; ++it)
+        memberIds.push_back(it->memberId);
+
+    return memberIds;
+}
+
+v_uint32 LeaderboardManager::getSize(void)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    return static_cast<v_uint32>(m_ranking.size());
+}
+
+void LeaderboardManager::addAttendance(v_uint32 memberId, const std::string& date)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    // Dates are compared as strings, just like the database does
+    if (date < m_windowStart)
+        return;
+
+    if (m_attendances[date].insert(memberId).second)
+        changeCount(memberId, true);
+}
+
+void LeaderboardManager::removeAttendance(v_uint32 memberId, const std::string& date)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    auto it = m_attendances.find(date);
+    if (it == m_attendances.end() || it->second.erase(memberId) == 0)
+        return;
+
+    if (it->second.empty())
+        m_attendances.erase(it);
+
+    changeCount(memberId, false);
+}
+
+bool LeaderboardManager::load(void)
+{
+    std::string windowStart;
+    if (!fetchWindowStart(windowStart))
+        return false;
+
+    auto dbResult = m_database->getAttendancesSince(windowStart);
+    if (!dbResult->isSuccess())
+    {
+        OATPP_LOGE(logName, "Failed to load the attendances: %s", dbResult->getErrorMessage()->c_str());
+        return false;
+    }
+
+    auto attendances = dbResult->fetch<oatpp::Vector<oatpp::Object<primus::dto::database::AttendanceDto>>>();
+
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    m_attendances.clear();
+    m_counts.clear();
+    m_ranking.clear();
+    m_windowStart = windowStart;
+
+    for (const auto& attendance : *attendances)
+    {
+        if (m_attendances[*attendance->date].insert(attendance->memberId).second)
+            ++m_counts[attendance->memberId];
+    }
+
+    for (const auto& count : m_counts)
+        m_ranking.insert(Rank{ count.second, count.first });
+
+    OATPP_LOGI(logName, "Loaded %d attendances of %d members since %s", static_cast<int>(attendances->size()), static_cast<int>(m_counts.size()), windowStart.c_str());
+    return true;
+}
+
+void LeaderboardManager::run(void)
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+
+    while (true)
+    {
+        // The window moves on at midnight (UTC), wake up one second later
+        const std::time_t now = std::time(nullptr);
+        const std::chrono::seconds untilMidnight(86400 - now % 86400 + 1);
+
+        if (m_wakeup.wait_for(lock, untilMidnight, [this] { return m_stop; }))
+            return;
+
+        lock.unlock();
+        sweep();
+        lock.lock();
+    }
+}
+
+bool LeaderboardManager::sweep(void)
+{
+    std::string windowStart;
+    if (!fetchWindowStart(windowStart))
+        return false;
+
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    v_uint32 dropped = 0;
+
+    // Dates are sorted, the outdated ones are at the front
+    auto it = m_attendances.begin();
+    while (it != m_attendances.end() && it->first < windowStart)
+    {
+        for (v_uint32 memberId : it->second)
+            changeCount(memberId, false);
+
+        dropped += static_cast<v_uint32>(it->second.size());
+        it = m_attendances.erase(it);
+    }
+
+    m_windowStart = windowStart;
+
+    OATPP_LOGI(logName, "Dropped %d attendances older than %s", static_cast<int>(dropped), windowStart.c_str());
+    return true;
+}
+
+void LeaderboardManager::changeCount(v_uint32 memberId, bool increment)
+{
+    v_uint32& count = m_counts[memberId];
+
+    if (count > 0)
+        m_ranking.erase(Rank{ count, memberId });
+
+    count = increment ? count + 1 : count - 1;
+
+    if (count > 0)
+        m_ranking.insert(Rank{ count, memberId });
+    else
+        m_counts.erase(memberId);
+}
+
+bool LeaderboardManager::fetchWindowStart(std::string& start)
+{
+    auto dbResult = m_database->getLeaderboardWindowStart();
+    if (!dbResult->isSuccess())
+    {
+        OATPP_LOGE(logName, "Failed to retrieve the start of the window: %s", dbResult->getErrorMessage()->c_str());
+        return false;
+    }
+
+    auto dates = dbResult->fetch<oatpp::Vector<oatpp::Object<primus::dto::database::DateDto>>>();
+    if (dates->empty() || !dates[0]->date)
+        return false;
+
+    start = *dates[0]->date;
+    return true;
+}
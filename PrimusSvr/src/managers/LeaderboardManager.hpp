@@ -0,0 +1,141 @@
+#ifndef LEADERBOARD_MANAGER_HPP
+#define LEADERBOARD_MANAGER_HPP
+
+#include <map>
+#include <set>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <string>
+#include <vector>
+#include <memory>
+
+#include "oatpp/core/Types.hpp"
+#include "oatpp/core/macro/component.hpp"
+#include "database/DatabaseClient.hpp"
+
+#include "general/constants.hpp"
+
+namespace primus {
+    namespace managers {
+        namespace Leaderboard {
+
+            /**
+             * @brief Ranks the members by their count of attendances within the last 6 months.
+             * The counts are loaded once and kept in memory, attendances are added and removed as they are set and deleted.
+             * Attendances leaving the window are dropped by a sweep running every day right after midnight (UTC).
+             */
+            class LeaderboardManager
+            {
+                static constexpr const char* logName = primus::constants::managers::manager_leaderboard::logName;
+
+                /**
+                 * @brief Position of a member in the ranking. Most attendances first, ties ordered by id.
+                 */
+                struct Rank
+                {
+                    v_uint32 attendances;
+                    v_uint32 memberId;
+
+                    bool operator<(const Rank& other) const
+                    {
+                        if (attendances != other.attendances)
+                            return attendances > other.attendances;
+                        return memberId < other.memberId;
+                    }
+                };
+
+            private:
+                OATPP_COMPONENT(std::shared_ptr<primus::component::DatabaseClient>, m_database);
+
+                std::map<std::string, std::set<v_uint32>>   m_attendances;  // Members attending per date, oldest date first
+                std::map<v_uint32, v_uint32>                m_counts;       // Attendances per member, members without any are not stored
+                std::set<Rank>                              m_ranking;
+                std::string                                 m_windowStart;
+                std::mutex                                  m_lock;
+                std::condition_variable                     m_wakeup;
+                bool                                        m_stop;
+                std::thread                                 m_sweeper;
+
+            private:
+                /**
+                 * @brief Constructor for the LeaderboardManager class. Loads the ranking and starts the daily sweep.
+                 */
+                LeaderboardManager(void);
+
+            public:
+                /**
+                 * @brief Destructor for the LeaderboardManager class. Stops the daily sweep.
+                 */
+                virtual ~LeaderboardManager(void);
+
+                /**
+                 * @brief Creates a shared pointer to a LeaderboardManager instance.
+                 * @return Shared pointer to the LeaderboardManager instance.
+                 */
+                static std::shared_ptr<LeaderboardManager> createShared(void);
+
+                /**
+                 * @brief Retrieves a page of the ranking.
+                 * @param limit Maximum count of members to return.
+                 * @param offset Count of ranks to skip.
+                 * @return Ids of the members, highest rank first.
+                 */
+                std::vector<v_uint32> getPage(v_uint32 limit, v_uint32 offset);
+
+                /**
+                 * @brief Retrieves the count of ranked members, i.e. members with at least one attendance in the window.
+                 * @return Count of ranked members.
+                 */
+                v_uint32 getSize(void);
+
+                /**
+                 * @brief Counts an attendance which was stored in the database. Attendances outside of the window are ignored.
+                 * @param memberId ID of the member.
+                 * @param date Date of the attendance (format: YYYY-MM-DD).
+                 */
+                void addAttendance(v_uint32 memberId, const std::string& date);
+
+                /**
+                 * @brief Removes an attendance which was deleted from the database.
+                 * @param memberId ID of the member.
+                 * @param date Date of the attendance (format: YYYY-MM-DD).
+                 */
+                void removeAttendance(v_uint32 memberId, const std::string& date);
+
+            private:
+                /**
+                 * @brief Replaces the ranking with the attendances stored in the database.
+                 * @return True if the ranking was loaded.
+                 */
+                bool load(void);
+
+                /**
+                 * @brief Main loop of the daily sweep.
+                 */
+                void run(void);
+
+                /**
+                 * @brief Drops all attendances older than the start of the window.
+                 * @return True if the start of the window could be retrieved.
+                 */
+                bool sweep(void);
+
+                /**
+                 * @brief Changes the attendance count of a member by one. Requires m_lock.
+                 */
+                void changeCount(v_uint32 memberId, bool increment);
+
+                /**
+                 * @brief Retrieves the first date of the window from the database.
+                 * @param start Receives the date.
+                 * @return True on success.
+                 */
+                bool fetchWindowStart(std::string& start);
+            };
+
+        } // namespace Leaderboard
+    } // namespace managers
+} // namespace primus
+
+#endif // LEADERBOARD_MANAGER_HPP
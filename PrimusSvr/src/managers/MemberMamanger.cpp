@@ -9,13 +9,16 @@ std::shared_ptr<MemberManager> MemberManager::createShared(void)
     return std::make_shared<MemberManager>(instance);
 }
 
-void MemberManager::getListAll(ObjMemberPageDto& page, const UInt32& limit, const UInt32& offset)
+void MemberManager::getListAll(ObjMemberPageDto& page, const UInt32& limit, const UInt32& offset, const String& after)
 {
     OATPP_LOGD(primus::constants::apicontroller::member_endpoint::logName, "Received request to get a list of all members. Limit: %d, Offset: %d", limit.operator v_uint32(), offset.operator v_uint32());
 
     std::shared_ptr<oatpp::orm::QueryResult> dbResult;
 
-    dbResult = m_database->getAllMembers(limit, offset);
+    if (after)
+        dbResult = m_database->getAllMembersAfter(decodeMemberCursor(after), limit);
+    else
+        dbResult = m_database->getAllMembers(limit, offset);
 
     PRIMUS_ASSERT_HTTP(dbResult->isSuccess(), 500, "Database request error", dbResult->getErrorMessage());
 
@@ -26,14 +29,21 @@ void MemberManager::getListAll(ObjMemberPageDto& page, const UInt32& limit, cons
         limit,
         offset
     );
+
+    MemberManager::setTotal(page, m_database->countMembersAll());
+
+    MemberManager::setNextMemberCursor(page, limit);
 }
-void MemberManager::getListActive(ObjMemberPageDto& page, const UInt32& limit, const UInt32& offset)
+void MemberManager::getListActive(ObjMemberPageDto& page, const UInt32& limit, const UInt32& offset, const String& after)
 {
     OATPP_LOGI(primus::constants::apicontroller::member_endpoint::logName, "Received request to get a list of all active members. Limit: %d, Offset: %d", limit.operator v_uint32(), offset.operator v_uint32());
 
     std::shared_ptr<oatpp::orm::QueryResult> dbResult;
 
-    dbResult = m_database->getActiveMembers(limit, offset);
+    if (after)
+        dbResult = m_database->getActiveMembersAfter(decodeMemberCursor(after), limit);
+    else
+        dbResult = m_database->getActiveMembers(limit, offset);
 
     PRIMUS_ASSERT_HTTP(dbResult->isSuccess(), 500, "Database request error", dbResult->getErrorMessage());
 
@@ -44,14 +54,21 @@ void MemberManager::getListActive(ObjMemberPageDto& page, const UInt32& limit, c
         limit,
         offset
     );
+
+    MemberManager::setTotal(page, m_database->countMembersActive());
+
+    MemberManager::setNextMemberCursor(page, limit);
 }
-void MemberManager::getListInactive(ObjMemberPageDto& page, const UInt32& limit, const UInt32& offset)
+void MemberManager::getListInactive(ObjMemberPageDto& page, const UInt32& limit, const UInt32& offset, const String& after)
 {
     OATPP_LOGI(primus::constants::apicontroller::member_endpoint::logName, "Received request to get a list of all inactive members. Limit: %d, Offset: %d", limit.operator v_uint32(), offset.operator v_uint32());
 
     std::shared_ptr<oatpp::orm::QueryResult> dbResult;
 
-    dbResult = m_database->getInactiveMembers(limit, offset);
+    if (after)
+        dbResult = m_database->getInactiveMembersAfter(decodeMemberCursor(after), limit);
+    else
+        dbResult = m_database->getInactiveMembers(limit, offset);
 
     PRIMUS_ASSERT_HTTP(dbResult->isSuccess(), 500, "Database request error", dbResult->getErrorMessage());
 
@@ -62,14 +79,21 @@ void MemberManager::getListInactive(ObjMemberPageDto& page, const UInt32& limit,
         limit,
         offset
     );
+
+    MemberManager::setTotal(page, m_database->countMembersInactive());
+
+    MemberManager::setNextMemberCursor(page, limit);
 }
 void MemberManager::getListBirthdayNext(ObjMemberPageDto& page, const UInt32& limit, const UInt32& offset)
 {
     OATPP_LOGI(primus::constants::apicontroller::member_endpoint::logName, "Received request to get a list of all members with upcomming birthdays. Limit: %d, Offset: %d", limit.operator v_uint32(), offset.operator v_uint32());
 
+    // The calendar is kept in memory, only the members of the page are read from the database
+    const std::vector<v_uint32> memberIds = m_birthdayManager->getNext(primus::date::formatMonthDay(std::time(nullptr)), limit, offset);
+
     std::shared_ptr<oatpp::orm::QueryResult> dbResult;
 
-    dbResult = m_database->getMembersWithUpcomingBirthday(limit, offset);
+    dbResult = m_database->getMembersByIds(MemberManager::joinIds(memberIds));
 
     PRIMUS_ASSERT_HTTP(dbResult->isSuccess(), 500, "Database request error", dbResult->getErrorMessage());
 
@@ -80,14 +104,19 @@ void MemberManager::getListBirthdayNext(ObjMemberPageDto& page, const UInt32& li
         limit,
         offset
     );
+
+    page->total = m_birthdayManager->getSize();
 }
 void MemberManager::getListAttendanceMost(ObjMemberPageDto& page, const UInt32& limit, const UInt32& offset)
 {
     OATPP_LOGI(primus::constants::apicontroller::member_endpoint::logName, "Received request to get a list of all members with most training. Limit: %d, Offset: %d", limit.operator v_uint32(), offset.operator v_uint32());
 
+    // The ranking is kept in memory, only the members of the page are read from the database
+    const std::vector<v_uint32> memberIds = m_leaderboardManager->getPage(limit, offset);
+
     std::shared_ptr<oatpp::orm::QueryResult> dbResult;
 
-    dbResult = m_database->getMembersByMostTraining(limit, offset);
+    dbResult = m_database->getMembersByIds(MemberManager::joinIds(memberIds));
 
     PRIMUS_ASSERT_HTTP(dbResult->isSuccess(), 500, "Database request error", dbResult->getErrorMessage());
 
@@ -98,17 +127,32 @@ void MemberManager::getListAttendanceMost(ObjMemberPageDto& page, const UInt32&
         limit,
         offset
     );
+
+    page->total = m_leaderboardManager->getSize();
 }
 
-void MemberManager::getList(ObjMemberPageDto& list, const String& attribute, const UInt32& limit, const UInt32& offset)
+void MemberManager::getList(ObjMemberPageDto& list, const String& attribute, const UInt32& limit, const UInt32& offset, const String& after)
 {
+    // An empty cursor starts a list from the beginning, just like no cursor
+    String cursor = after;
+    if (cursor && cursor->empty())
+        cursor = nullptr;
+
     switch (stringToMembersList(attribute))
     {
-        case MembersLists::all:         return getListAll               (list, limit, offset);
-        case MembersLists::active:      return getListActive            (list, limit, offset);
-        case MembersLists::inactive:    return getListInactive          (list, limit, offset);
-        case MembersLists::birthday:    return getListBirthdayNext      (list, limit, offset);
-        case MembersLists::attendance:  return getListAttendanceMost    (list, limit, offset);
+        case MembersLists::all:         return getListAll               (list, limit, offset, cursor);
+        case MembersLists::active:      return getListActive            (list, limit, offset, cursor);
+        case MembersLists::inactive:    return getListInactive          (list, limit, offset, cursor);
+        case MembersLists::birthday:
+        case MembersLists::attendance:
+        {
+            // These lists are not sorted by a unique key, a cursor can not mark a position in them
+            PRIMUS_ASSERT_HTTP(!cursor, 400, "CURSOR NOT SUPPORTED", "The lists birthday and attendance only support pagination by offset");
+
+            if (stringToMembersList(attribute) == MembersLists::birthday)
+                return getListBirthdayNext(list, limit, offset);
+            return getListAttendanceMost(list, limit, offset);
+        }
         default:
         {
             char errorMsg[256];
@@ -156,6 +200,28 @@ MemberManager::UInt32 MemberManager::countAttribute(const UInt32& memberId, Stri
     return MemberManager::UInt32(static_cast<uint32_t>(0));
 }
 
+void MemberManager::rebuildStats(void)
+{
+    OATPP_LOGI(MemberManager::logName, "Rebuilding member and attendance counters");
+
+    // Members and attendances can not change in between, the counters are consistent with the tables afterwards
+    auto transaction = m_database->beginTransaction();
+
+    auto dbResult = m_database->rebuildStats(transaction.getConnection());
+    PRIMUS_ASSERT_HTTP(dbResult->isSuccess(), 500, "Database request error", dbResult->getErrorMessage());
+
+    dbResult = m_database->clearMemberStats(transaction.getConnection());
+    PRIMUS_ASSERT_HTTP(dbResult->isSuccess(), 500, "Database request error", dbResult->getErrorMessage());
+
+    dbResult = m_database->rebuildMemberStats(transaction.getConnection());
+    PRIMUS_ASSERT_HTTP(dbResult->isSuccess(), 500, "Database request error", dbResult->getErrorMessage());
+
+    dbResult = transaction.commit();
+    PRIMUS_ASSERT_HTTP(dbResult->isSuccess(), 500, "Database request error", dbResult->getErrorMessage());
+
+    OATPP_LOGI(MemberManager::logName, "Rebuilt member and attendance counters");
+}
+
 void MemberManager::addMemberToDepartment(const UInt32& memberId, const UInt32& departmentId)
 {
     
@@ -224,6 +290,241 @@ void MemberManager::getMemberAttendances(const UInt32& memberId, const UInt32& l
 
 bool MemberManager::checkFirearmPurchasePermission(const UInt32& memberId)
 {
-    
-    return false;
+    auto eligibility = EligibilityDto::createShared();
+    eligibility->id = memberId;
+
+    MemberManager::evaluateFirearmPurchasePermission(eligibility, MemberManager::getOneYearAgo());
+
+    OATPP_LOGI(MemberManager::logName, "Member %d attended %d sessions in %d distinct months last year", memberId.operator v_uint32(), eligibility->attendances.operator v_uint32(), eligibility->months.operator v_uint32());
+
+    return eligibility->eligible;
+}
+
+oatpp::Vector<MemberManager::ObjEligibilityDto> MemberManager::getFirearmEligibility(const String& attribute, v_uint32 afterId, v_uint32 limit)
+{
+    std::shared_ptr<oatpp::orm::QueryResult> dbResult;
+
+    switch (stringToMembersList(attribute))
+    {
+        case MembersLists::all:         dbResult = m_database->getAllMembersAfter(afterId, limit);      break;
+        case MembersLists::active:      dbResult = m_database->getActiveMembersAfter(afterId, limit);   break;
+        case MembersLists::inactive:    dbResult = m_database->getInactiveMembersAfter(afterId, limit); break;
+        default:
+            PRIMUS_THROW_STATUS_EXCEP(400, "ATTRIBUTE NOT FOUND", "Available attributes are: all, active, inactive");
+    }
+
+    PRIMUS_ASSERT_HTTP(dbResult->isSuccess(), 500, "Database request error", dbResult->getErrorMessage());
+
+    auto members = dbResult->fetch<oatpp::Vector<ObjMemberDto>>();
+    auto results = oatpp::Vector<ObjEligibilityDto>::createShared();
+    results->reserve(members->size());
+
+    const int oneYearAgo = MemberManager::getOneYearAgo();
+
+    for (const auto& member : *members)
+    {
+        auto eligibility = EligibilityDto::createShared();
+        eligibility->id        = member->id;
+        eligibility->firstName = member->firstName;
+        eligibility->lastName  = member->lastName;
+
+        MemberManager::evaluateFirearmPurchasePermission(eligibility, oneYearAgo);
+        results->push_back(eligibility);
+    }
+
+    return results;
+}
+
+void MemberManager::evaluateFirearmPurchasePermission(ObjEligibilityDto& eligibility, int oneYearAgo)
+{
+    eligibility->attendances = m_attendanceIndex->countSince(eligibility->id, oneYearAgo);
+    eligibility->months      = m_attendanceIndex->countMonthsSince(eligibility->id, oneYearAgo);
+
+    // 18 sessions within the last year or at least one session in every month
+    eligibility->eligible    = eligibility->attendances >= 18 || eligibility->months == 12;
+}
+
+MemberManager::ObjProfileDto MemberManager::getProfile(const UInt32& memberId, v_uint32 sections, const UInt32& limit, const UInt32& offset)
+{
+    using namespace primus::constants::apicontroller::member_endpoint;
+
+    const v_uint32 countedSections = ProfileSections::addresses | ProfileSections::departments | ProfileSections::fee | ProfileSections::attendanceCount | ProfileSections::attendances;
+
+    auto profile = ProfileDto::createShared();
+
+    // Nothing is written, the transaction only makes all queries read the same snapshot. It ends when it goes out of scope
+    auto transaction = m_database->beginReadTransaction();
+    auto connection = transaction.getConnection();
+
+    auto dbResult = m_database->getMemberById(memberId, connection);
+    PRIMUS_ASSERT_HTTP(dbResult->isSuccess(), 500, "Database request error", dbResult->getErrorMessage());
+
+    auto members = dbResult->fetch<oatpp::Vector<ObjMemberDto>>();
+    PRIMUS_ASSERT_HTTP(!members->empty(), 404, "NOT FOUND", "Member not found");
+
+    if (sections & ProfileSections::member)
+        profile->member = members[0];
+
+    oatpp::Object<primus::dto::database::ProfileCountsDto> counts;
+    if (sections & countedSections)
+    {
+        dbResult = m_database->getProfileCountsOfMember(memberId, connection);
+        PRIMUS_ASSERT_HTTP(dbResult->isSuccess(), 500, "Database request error", dbResult->getErrorMessage());
+
+        auto rows = dbResult->fetch<oatpp::Vector<oatpp::Object<primus::dto::database::ProfileCountsDto>>>();
+        PRIMUS_ASSERT_HTTP((rows->size() == 1), 500, "Database request error", "Failed to count the lists of the member");
+        counts = rows[0];
+    }
+
+    if (sections & ProfileSections::addresses)
+    {
+        dbResult = m_database->getMemberAddresses(memberId, profileListLimit, static_cast<v_uint32>(0), connection);
+        profile->addresses = MemberManager::createPage<primus::dto::AddressPageDto, AddressDto>(dbResult, profileListLimit, static_cast<v_uint32>(0), counts->addresses);
+    }
+
+    // The fee depends on the departments, the page is read if either of them is requested
+    if (sections & (ProfileSections::departments | ProfileSections::fee))
+    {
+        const v_uint32 departmentLimit = (sections & ProfileSections::departments) ? profileListLimit : 1;
+
+        dbResult = m_database->getMemberDepartments(memberId, departmentLimit, static_cast<v_uint32>(0), connection);
+        auto departments = MemberManager::createPage<primus::dto::DepartmentPageDto, primus::dto::database::DepartmentDto>(dbResult, departmentLimit, static_cast<v_uint32>(0), counts->departments);
+
+        if (sections & ProfileSections::fee)
+            profile->fee = primus::managers::Fee::FeeManager::calculateFee(counts->departments, departments->items->empty() ? 0 : departments->items[0]->id.operator v_uint32());
+
+        if (sections & ProfileSections::departments)
+            profile->departments = departments;
+    }
+
+    if (sections & ProfileSections::weaponPurchase)
+    {
+        // Answered from the attendance index, the database is not involved
+        auto eligibility = EligibilityDto::createShared();
+        eligibility->id        = members[0]->id;
+        eligibility->firstName = members[0]->firstName;
+        eligibility->lastName  = members[0]->lastName;
+
+        MemberManager::evaluateFirearmPurchasePermission(eligibility, MemberManager::getOneYearAgo());
+        profile->weaponPurchase = eligibility;
+    }
+
+    if (sections & ProfileSections::attendanceCount)
+        profile->attendanceCount = counts->attendances;
+
+    if (sections & ProfileSections::attendances)
+    {
+        dbResult = m_database->getAttendancesOfMember(memberId, limit, offset, connection);
+        profile->attendances = MemberManager::createPage<primus::dto::DatePageDto, primus::dto::database::DateDto>(dbResult, limit, offset, counts->attendances);
+
+        // Same cursor as the attendance list of the member, so further pages can be read from there
+        auto& items = profile->attendances->items;
+        if (!items->empty() && items->size() >= limit.operator v_uint32() && items->back()->date)
+            profile->attendances->nextCursor = primus::cursor::encode(cursorAttendances, items->back()->date);
+    }
+
+    OATPP_LOGI(MemberManager::logName, "Read the profile of member %d", memberId.operator v_uint32());
+
+    return profile;
+}
+
+MemberManager::ObjMemberBatchDto MemberManager::getMemberBatch(const std::vector<v_uint32>& ids, const std::vector<std::string>& include)
+{
+    bool withAttendances = false;
+    for (const std::string& name : include)
+    {
+        PRIMUS_ASSERT_HTTP((name == "attendances"), 400, "INVALID INCLUDE", "Available aggregates are: attendances");
+        withAttendances = true;
+    }
+
+    // Every member once, in the order of the request
+    std::vector<v_uint32> uniqueIds;
+    std::set<v_uint32> requested;
+    for (v_uint32 id : ids)
+    {
+        if (requested.insert(id).second)
+            uniqueIds.push_back(id);
+    }
+
+    const std::size_t maxIds = primus::constants::apicontroller::member_endpoint::batchMaxIds;
+    PRIMUS_ASSERT_HTTP((uniqueIds.size() <= maxIds), 400, "TOO MANY IDS", "At most " + std::to_string(maxIds) + " members can be requested at once");
+
+    auto batch = MemberBatchDto::createShared();
+    batch->members = oatpp::Fields<oatpp::Object<MemberBatchEntryDto>>::createShared();
+    batch->missing = oatpp::Vector<UInt32>::createShared();
+
+    if (uniqueIds.empty())
+        return batch;
+
+    auto dbResult = m_database->getMembersByIds(MemberManager::joinIds(uniqueIds));
+    PRIMUS_ASSERT_HTTP(dbResult->isSuccess(), 500, "Database request error", dbResult->getErrorMessage());
+
+    auto members = dbResult->fetch<oatpp::Vector<ObjMemberDto>>();
+
+    for (const auto& member : *members)
+    {
+        const v_uint32 memberId = member->id;
+
+        auto entry = MemberBatchEntryDto::createShared();
+        entry->member = member;
+
+        // Answered from the attendance index, the database is not involved
+        if (withAttendances)
+            entry->attendances = m_attendanceIndex->count(memberId);
+
+        batch->members->push_back({ oatpp::String(std::to_string(memberId)), entry });
+        requested.erase(memberId);
+    }
+
+    for (v_uint32 id : uniqueIds)
+    {
+        if (requested.count(id) != 0)
+            batch->missing->push_back(id);
+    }
+
+    OATPP_LOGI(MemberManager::logName, "Read %d of %d requested members at once", static_cast<int>(members->size()), static_cast<int>(uniqueIds.size()));
+
+    return batch;
+}
+
+std::vector<v_uint32> MemberManager::parseIds(const String& text)
+{
+    std::vector<v_uint32> ids;
+
+    for (const std::string& item : MemberManager::splitList(text))
+    {
+        bool success = !item.empty();
+        const v_uint32 id = success ? oatpp::utils::conversion::strToUInt32(oatpp::String(item), success) : 0;
+        PRIMUS_ASSERT_HTTP(success, 400, "INVALID ID", "The ids have to be a comma separated list of numbers");
+
+        ids.push_back(id);
+    }
+
+    return ids;
+}
+
+std::vector<std::string> MemberManager::splitList(const String& text)
+{
+    std::vector<std::string> items;
+    if (!text || text->empty())
+        return items;
+
+    std::size_t start = 0;
+    for (;;)
+    {
+        const std::size_t end = text->find(',', start);
+        items.push_back(text->substr(start, end == std::string::npos ? std::string::npos : end - start));
+
+        if (end == std::string::npos)
+            return items;
+
+        start = end + 1;
+    }
+}
+
+int MemberManager::getOneYearAgo(void)
+{
+    int year, month, day;
+    primus::date::civilFromDays(primus::date::today(), year, month, day);
+    return primus::date::daysFromCivil(year - 1, month, day);
 }
@@ -2,19 +2,31 @@
 #define MEMBER_MANAGER_HPP
 
 #include <map>
+#include <set>
 #include <string>
+#include <vector>
 #include <memory>
+#include <ctime>
 
 #include "oatpp/core/Types.hpp"
 #include "oatpp/web/server/api/ApiController.hpp"
 #include "oatpp/core/macro/component.hpp"
 #include "database/DatabaseClient.hpp"
+#include "managers/LeaderboardManager.hpp"
+#include "managers/BirthdayManager.hpp"
+#include "managers/AttendanceIndex.hpp"
+#include "managers/FeeManager.hpp"
 
 #include "general/constants.hpp"
 #include "dto/DatabaseDtos.hpp"
 #include "dto/Int32Dto.hpp"
 #include "dto/PageDto.hpp"
+#include "dto/EligibilityDto.hpp"
+#include "dto/ProfileDto.hpp"
+#include "dto/MemberBatchDto.hpp"
 #include "general/exceptions.hpp"
+#include "general/cursor.hpp"
+#include "general/date.hpp"
 
 namespace primus {
     namespace managers {
@@ -49,6 +61,61 @@ namespace primus {
                 return MembersLists::null; // Default value for unknown strings
             }
 
+            /**
+             * @brief Sections of the member profile, combined as bit mask
+             */
+            namespace ProfileSections
+            {
+                constexpr v_uint32 member          = 1u << 0;
+                constexpr v_uint32 addresses       = 1u << 1;
+                constexpr v_uint32 departments     = 1u << 2;
+                constexpr v_uint32 fee             = 1u << 3;
+                constexpr v_uint32 weaponPurchase  = 1u << 4;
+                constexpr v_uint32 attendanceCount = 1u << 5;
+                constexpr v_uint32 attendances     = 1u << 6;
+                constexpr v_uint32 all             = (1u << 7) - 1;
+            }
+
+            /**
+             * @brief Converts the comma separated names of profile sections to a bit mask, see ProfileSections.
+             * Throws 400 if a name is unknown.
+             * @param fields Names of the sections. All sections if null or empty.
+             */
+            static v_uint32 stringToProfileSections(const oatpp::String& fields)
+            {
+                static const std::map<std::string, v_uint32> enumMap =
+                {
+                    {"member"         , ProfileSections::member},
+                    {"addresses"      , ProfileSections::addresses},
+                    {"departments"    , ProfileSections::departments},
+                    {"fee"            , ProfileSections::fee},
+                    {"weaponPurchase" , ProfileSections::weaponPurchase},
+                    {"attendanceCount", ProfileSections::attendanceCount},
+                    {"attendances"    , ProfileSections::attendances}
+                };
+
+                if (!fields || fields->empty())
+                    return ProfileSections::all;
+
+                v_uint32 sections = 0;
+                std::size_t start = 0;
+
+                while (start <= fields->size())
+                {
+                    std::size_t end = fields->find(',', start);
+                    if (end == std::string::npos)
+                        end = fields->size();
+
+                    auto it = enumMap.find(fields->substr(start, end - start));
+                    PRIMUS_ASSERT_HTTP((it != enumMap.end()), 400, "INVALID FIELDS", "Available fields are: member, addresses, departments, fee, weaponPurchase, attendanceCount, attendances");
+
+                    sections |= it->second;
+                    start = end + 1;
+                }
+
+                return sections;
+            }
+
             /**
              * @brief Manages members and provides functionality related to the member endpoints
              */
@@ -62,15 +129,25 @@ namespace primus {
                 using MemberPageDto = primus::dto::MemberPageDto;
                 using UInt32Dto = primus::dto::UInt32Dto;
                 using Int32Dto = primus::dto::Int32Dto;
+                using EligibilityDto = primus::dto::EligibilityDto;
+                using ProfileDto = primus::dto::ProfileDto;
+                using MemberBatchDto = primus::dto::MemberBatchDto;
+                using MemberBatchEntryDto = primus::dto::MemberBatchEntryDto;
 
                 using ObjMemberDto  = oatpp::Object<MemberDto>;
                 using ObjAddressDto = oatpp::Object <AddressDto>;
                 using ObjMemberPageDto = oatpp::Object<MemberPageDto>;
+                using ObjEligibilityDto = oatpp::Object<EligibilityDto>;
+                using ObjProfileDto = oatpp::Object<ProfileDto>;
+                using ObjMemberBatchDto = oatpp::Object<MemberBatchDto>;
 
                 static constexpr const char* logName = primus::constants::managers::manager_member::logName;
 
             private:
                 OATPP_COMPONENT(std::shared_ptr<primus::component::DatabaseClient>, m_database);
+                OATPP_COMPONENT(std::shared_ptr<primus::managers::Leaderboard::LeaderboardManager>, m_leaderboardManager);
+                OATPP_COMPONENT(std::shared_ptr<primus::managers::Birthday::BirthdayManager>, m_birthdayManager);
+                OATPP_COMPONENT(std::shared_ptr<primus::managers::Attendance::AttendanceIndex>, m_attendanceIndex);
 
 
             private:
@@ -95,13 +172,14 @@ namespace primus {
                  * @brief Retrieves a list of members based on a specified attribute.
                  * @param attribute The attribute to filter the list by.
                  * @param limit The maximum number of members to retrieve.
-                 * @param offset The offset for pagination.
+                 * @param offset The offset for pagination. Ignored if a cursor is given.
+                 * @param after Cursor returned as nextCursor of the previous page. Only supported by the lists all, active and inactive.
                  */
-                void getList(ObjMemberPageDto& page, const String& attribute, const UInt32& limit, const UInt32& offset);
+                void getList(ObjMemberPageDto& page, const String& attribute, const UInt32& limit, const UInt32& offset, const String& after = nullptr);
             private:
-                void getListAll(ObjMemberPageDto& page, const UInt32& limit, const UInt32& offset);
-                void getListActive(ObjMemberPageDto& page, const UInt32& limit, const UInt32& offset);
-                void getListInactive(ObjMemberPageDto& page, const UInt32& limit, const UInt32& offset);
+                void getListAll(ObjMemberPageDto& page, const UInt32& limit, const UInt32& offset, const String& after);
+                void getListActive(ObjMemberPageDto& page, const UInt32& limit, const UInt32& offset, const String& after);
+                void getListInactive(ObjMemberPageDto& page, const UInt32& limit, const UInt32& offset, const String& after);
                 void getListBirthdayNext(ObjMemberPageDto& page, const UInt32& limit, const UInt32& offset);
                 void getListAttendanceMost(ObjMemberPageDto& page, const UInt32& limit, const UInt32& offset);
 
@@ -155,6 +233,13 @@ namespace primus {
                  */
                 UInt32 countAttribute(const UInt32& memberId, String& attribute);
 
+                /**
+                 * @brief Recomputes the member and attendance counters from the tables.
+                 * The counters are kept up to date by triggers, this is only needed to repair them
+                 * after the tables were changed with the triggers disabled, e.g. by an import.
+                 */
+                void rebuildStats(void);
+
                 /**
                  * @brief Adds a member to a department.
                  * @param memberId The ID of the member to add to the department.
@@ -253,11 +338,70 @@ namespace primus {
 
                 /**
                  * @brief Checks if a member has permission to purchase a firearm.
+                 * Requires 18 attendances within the last year or attendances in every month of the last year.
                  * @param memberId The ID of the member to check for permission.
                  * @return True if the member has permission, false otherwise.
                  */
                 bool checkFirearmPurchasePermission(const UInt32& memberId);
 
+                /**
+                 * @brief Evaluates checkFirearmPurchasePermission for a page of members at once.
+                 * The members are read with a single keyset query, the attendances come from the attendance index.
+                 * @param attribute The members to evaluate (options: all, active, inactive).
+                 * @param afterId Only members with a greater ID are evaluated. 0 to start with the first member.
+                 * @param limit Maximum count of members to evaluate.
+                 * @return The results sorted by ID. Fewer than limit if there are no more members.
+                 */
+                oatpp::Vector<ObjEligibilityDto> getFirearmEligibility(const String& attribute, v_uint32 afterId, v_uint32 limit);
+
+                /**
+                 * @brief Retrieves everything shown on the profile of a member at once.
+                 * All queries run on one read-only connection inside a transaction, so the sections are consistent with each other
+                 * and the existence of the member is checked only once.
+                 * @param memberId The ID of the member.
+                 * @param sections The sections to fill, see ProfileSections. The others stay null.
+                 * @param limit The maximum number of attendances to retrieve.
+                 * @param offset The offset of the attendances.
+                 * @return The profile of the member.
+                 */
+                ObjProfileDto getProfile(const UInt32& memberId, v_uint32 sections, const UInt32& limit, const UInt32& offset);
+
+                /**
+                 * @brief Retrieves several members with a single query.
+                 * @param ids The IDs of the members. Duplicates are ignored. At most batchMaxIds different ones.
+                 * @param include Names of the aggregates to add to every member (options: attendances).
+                 * @return The members keyed by their ID and the IDs without a member.
+                 */
+                ObjMemberBatchDto getMemberBatch(const std::vector<v_uint32>& ids, const std::vector<std::string>& include);
+
+                /**
+                 * @brief Parses a comma separated list of member IDs, e.g. a query parameter. Throws 400 if an ID is not a number.
+                 * @param text The list. Empty if null.
+                 * @return The IDs in the order of the list.
+                 */
+                static std::vector<v_uint32> parseIds(const String& text);
+
+                /**
+                 * @brief Splits a comma separated list, e.g. a query parameter.
+                 * @param text The list.
+                 * @return The items of the list. Empty if the text is null or empty.
+                 */
+                static std::vector<std::string> splitList(const String& text);
+
+            private:
+                /**
+                 * @brief Fills the attendances of a member within the last year and whether they allow to purchase a firearm.
+                 * @param eligibility Receives the result. The id has to be set.
+                 * @param oneYearAgo First day of the last year, see getOneYearAgo.
+                 */
+                void evaluateFirearmPurchasePermission(ObjEligibilityDto& eligibility, int oneYearAgo);
+
+                /**
+                 * @brief Retrieves the first day of the last year, the same as DATE('now', '-1 year').
+                 * @return Count of days since 1970-01-01.
+                 */
+                static int getOneYearAgo(void);
+
             private:
                 static inline void fillMemberPage(ObjMemberPageDto& page, const std::shared_ptr<oatpp::orm::QueryResult> dbResult, const UInt32& limit, const UInt32& offset)
                 {
@@ -266,6 +410,69 @@ namespace primus {
                     page->limit  = limit;
                     page->offset = offset;
                 }
+
+                /**
+                 * @brief Creates a page of a list of a member from the result of a paged query.
+                 */
+                template<class PageDto, class ItemDto>
+                static inline oatpp::Object<PageDto> createPage(const std::shared_ptr<oatpp::orm::QueryResult>& dbResult, const UInt32& limit, const UInt32& offset, v_uint32 total)
+                {
+                    PRIMUS_ASSERT_HTTP(dbResult->isSuccess(), 500, "Database request error", dbResult->getErrorMessage());
+
+                    auto page = PageDto::createShared();
+                    page->items  = dbResult->fetch<oatpp::Vector<oatpp::Object<ItemDto>>>();
+                    page->count  = static_cast<v_uint32>(page->items->size());
+                    page->limit  = limit;
+                    page->offset = offset;
+                    page->total  = total;
+                    return page;
+                }
+
+                /**
+                 * @brief Joins member ids to the comma separated list expected by getMembersByIds.
+                 */
+                static inline std::string joinIds(const std::vector<v_uint32>& memberIds)
+                {
+                    std::string ids;
+                    for (v_uint32 memberId : memberIds)
+                    {
+                        if (!ids.empty())
+                            ids += ',';
+                        ids += std::to_string(memberId);
+                    }
+                    return ids;
+                }
+
+                /**
+                 * @brief Sets the total count of items of the list a page belongs to.
+                 */
+                static inline void setTotal(ObjMemberPageDto& page, const primus::component::CachedQueryResult& total)
+                {
+                    PRIMUS_ASSERT_HTTP(total.isSuccess(), 500, "Database request error", total.getErrorMessage());
+                    page->total = static_cast<v_uint32>(total.value);
+                }
+
+                /**
+                 * @brief Sets the cursor of the page following a member list sorted by id. Left null if the list is exhausted.
+                 */
+                static inline void setNextMemberCursor(ObjMemberPageDto& page, const UInt32& limit)
+                {
+                    if (page->items->empty() || page->items->size() < limit.operator v_uint32())
+                        return;
+
+                    page->nextCursor = primus::cursor::encodeId(primus::constants::apicontroller::member_endpoint::cursorMembers, page->items->back()->id);
+                }
+
+                /**
+                 * @brief Decodes the cursor of a member list sorted by id.
+                 * @return Id of the last member of the previous page.
+                 */
+                static inline v_uint32 decodeMemberCursor(const String& after)
+                {
+                    v_uint32 afterId = 0;
+                    PRIMUS_ASSERT_HTTP(primus::cursor::decodeId(after, primus::constants::apicontroller::member_endpoint::cursorMembers, afterId), 400, "INVALID CURSOR", "The cursor passed as 'after' is malformed or belongs to another list");
+                    return afterId;
+                }
             };
 
         } // namespace Members
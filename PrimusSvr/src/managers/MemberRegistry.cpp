@@ -0,0 +1,78 @@
+#include "MemberRegistry.hpp"
+
+#include "dto/Int32Dto.hpp"
+
+using MemberRegistry = primus::managers::Registry::MemberRegistry;
+using UInt32Dto      = primus::dto::UInt32Dto;
+
+MemberRegistry::MemberRegistry(void)
+{
+    load();
+}
+
+std::shared_ptr<MemberRegistry> MemberRegistry::createShared(void)
+{
+    return std::shared_ptr<MemberRegistry>(new MemberRegistry());
+}
+
+bool MemberRegistry::exists(v_uint32 memberId, bool& success)
+{
+    success = true;
+
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        if (m_ids.count(memberId) != 0)
+            return true;
+    }
+
+    auto dbResult = m_database->existsMemberById(memberId);
+    if (!dbResult.isSuccess())
+    {
+        OATPP_LOGE(logName, "Failed to check whether member %d exists: %s", memberId, dbResult.getErrorMessage()->c_str());
+        success = false;
+        return false;
+    }
+
+    if (dbResult.value == 0)
+        return false;
+
+    add(memberId);
+    return true;
+}
+
+bool MemberRegistry::isKnown(v_uint32 memberId)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    return m_ids.count(memberId) != 0;
+}
+
+void MemberRegistry::add(v_uint32 memberId)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_ids.insert(memberId);
+}
+
+bool MemberRegistry::load(void)
+{
+    auto dbResult = m_database->getAllMemberIds();
+    if (!dbResult->isSuccess())
+    {
+        OATPP_LOGE(logName, "Failed to load the member ids: %s", dbResult->getErrorMessage()->c_str());
+        return false;
+    }
+
+    auto ids = dbResult->fetch<oatpp::Vector<oatpp::Object<UInt32Dto>>>();
+
+    std::unordered_set<v_uint32> members;
+    members.reserve(ids->size());
+
+    for (const auto& id : *ids)
+        members.insert(id->value);
+
+    OATPP_LOGI(logName, "Loaded the ids of %d members", static_cast<int>(members.size()));
+
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_ids.swap(members);
+
+    return true;
+}
@@ -0,0 +1,86 @@
+#ifndef MEMBER_REGISTRY_HPP
+#define MEMBER_REGISTRY_HPP
+
+#include <mutex>
+#include <unordered_set>
+#include <memory>
+
+#include "oatpp/core/Types.hpp"
+#include "oatpp/core/macro/component.hpp"
+#include "database/DatabaseClient.hpp"
+
+#include "general/constants.hpp"
+
+namespace primus {
+    namespace managers {
+        namespace Registry {
+
+            /**
+             * @brief Ids of all members, kept in memory to check whether a member exists without asking the database.
+             * Members are never deleted, so a known id stays valid. Unknown ids are looked up in the database once more,
+             * which covers members inserted by other means than the API, e.g. an import.
+             */
+            class MemberRegistry
+            {
+                static constexpr const char* logName = primus::constants::managers::manager_registry::logName;
+
+            private:
+                OATPP_COMPONENT(std::shared_ptr<primus::component::DatabaseClient>, m_database);
+
+                std::unordered_set<v_uint32>    m_ids;
+                std::mutex                      m_lock;
+
+            private:
+                /**
+                 * @brief Constructor for the MemberRegistry class. Loads the ids of all members.
+                 */
+                MemberRegistry(void);
+
+            public:
+                /**
+                 * @brief Destructor for the MemberRegistry class.
+                 */
+                virtual ~MemberRegistry(void) = default;
+
+                /**
+                 * @brief Creates a shared pointer to a MemberRegistry instance.
+                 * @return Shared pointer to the MemberRegistry instance.
+                 */
+                static std::shared_ptr<MemberRegistry> createShared(void);
+
+                /**
+                 * @brief Checks whether a member exists.
+                 * Known members are answered from memory, only unknown ids cost a query.
+                 * @param memberId ID of the member.
+                 * @param success Set to false if the database could not be asked.
+                 * @return True if the member exists.
+                 */
+                bool exists(v_uint32 memberId, bool& success);
+
+                /**
+                 * @brief Checks whether a member is known, without asking the database.
+                 * Members inserted by other means than the API are unknown until exists found them.
+                 * @param memberId ID of the member.
+                 * @return True if the member is known.
+                 */
+                bool isKnown(v_uint32 memberId);
+
+                /**
+                 * @brief Adds a member which was stored in the database.
+                 * @param memberId ID of the member.
+                 */
+                void add(v_uint32 memberId);
+
+            private:
+                /**
+                 * @brief Replaces the registry with the ids stored in the database.
+                 * @return True if the ids were loaded.
+                 */
+                bool load(void);
+            };
+
+        } // namespace Registry
+    } // namespace managers
+} // namespace primus
+
+#endif // MEMBER_REGISTRY_HPP
@@ -0,0 +1,357 @@
+#include "StaticManager.hpp"
+
+#include <set>
+#include <vector>
+#include <utility>
+#include <fstream>
+#include <cstdio>
+#include <cstdlib>
+#include <cctype>
+
+#include "filesystemHelper.hpp"
+#include "general/mime.hpp"
+#include "general/hash.hpp"
+#include "general/compression.hpp"
+#include "general/date.hpp"
+
+using StaticManager = primus::managers::Static::StaticManager;
+using StaticAsset   = primus::managers::Static::StaticAsset;
+using StaticAssetVariant = primus::managers::Static::StaticAssetVariant;
+
+namespace {
+    /**
+     * @brief Checks whether a string ends with the given suffix.
+     */
+    bool endsWith(const std::string& value, const std::string& suffix)
+    {
+        return value.size() >= suffix.size() && value.compare(value.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+}
+
+StaticManager::StaticManager(const std::string& directory)
+    : m_directory(directory)
+{
+    reload();
+}
+
+std::shared_ptr<StaticManager> StaticManager::createShared(const std::string& directory)
+{
+    return std::shared_ptr<StaticManager>(new StaticManager(directory));
+}
+
+std::shared_ptr<const StaticAsset> StaticManager::getAsset(const std::string& relativePath)
+{
+    const std::string key = relativePath.empty() ? "index.html" : relativePath;
+
+#ifdef PRIMUS_EMBED_WEB_ASSETS
+    {
+        // Embedded files never change and there is nothing else to serve
+        std::lock_guard<std::mutex> guard(m_lock);
+
+        auto it = m_assets.find(key);
+        return it != m_assets.end() ? it->second.asset : nullptr;
+    }
+#endif
+
+    const auto now = std::chrono::steady_clock::now();
+
+    Asset cached;
+
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+
+        auto it = m_assets.find(key);
+        if (it != m_assets.end())
+        {
+            if (now - it->second.checked < std::chrono::seconds(primus::constants::managers::manager_static::revalidateSeconds))
+                return it->second.asset;
+
+            it->second.checked = now;
+            cached = it->second.asset;
+        }
+    }
+
+    if (cached)
+    {
+        primus::component::filesystem::FileInfo info;
+        const bool exists = primus::component::filesystem::getFileInfo(cached->filePath, info);
+
+        if (exists && info.modified == cached->modified && info.size == cached->contentLength)
+            return cached;
+
+        OATPP_LOGI(logName, "File %s changed on disk. Reloading", cached->filePath.c_str());
+    }
+    else if (!isSafePath(key))
+    {
+        OATPP_LOGI(logName, "Refusing to serve path outside of the web directory: %s", key.c_str());
+        return nullptr;
+    }
+
+    Asset asset = loadAsset(m_directory + "/" + key);
+
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    if (asset)
+        m_assets[key] = CacheEntry{ asset, now };
+    else
+        m_assets.erase(key);
+
+    return asset;
+}
+
+v_uint32 StaticManager::reload(void)
+{
+#ifdef PRIMUS_EMBED_WEB_ASSETS
+    {
+        std::map<std::string, CacheEntry> assets;
+        const auto now = std::chrono::steady_clock::now();
+
+        for (std::size_t i = 0; i < primus::embedded::assetCount; ++i)
+        {
+            const primus::embedded::EmbeddedAsset& embedded = primus::embedded::assets[i];
+            assets[embedded.path] = CacheEntry{ createEmbeddedAsset(embedded), now };
+        }
+
+        OATPP_LOGI(logName, "Loaded %d files embedded into the executable", static_cast<int>(assets.size()));
+
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_assets.swap(assets);
+
+        return static_cast<v_uint32>(m_assets.size());
+    }
+#endif
+
+    std::vector<std::string> files;
+    primus::component::filesystem::listFilesRecursive(m_directory, "", files);
+
+    std::map<std::string, CacheEntry> assets;
+    const auto now = std::chrono::steady_clock::now();
+    const std::set<std::string> fileSet(files.begin(), files.end());
+
+    for (const auto& file : files)
+    {
+        // Precompressed siblings are served as variants of their original file
+        if ((endsWith(file, ".gz") || endsWith(file, ".br")) && fileSet.count(file.substr(0, file.size() - 3)) != 0)
+            continue;
+
+        Asset asset = loadAsset(m_directory + "/" + file);
+        if (asset)
+            assets[file] = CacheEntry{ asset, now };
+    }
+
+    OATPP_LOGI(logName, "Loaded %d files from %s", static_cast<int>(assets.size()), m_directory.c_str());
+
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_assets.swap(assets);
+
+    return static_cast<v_uint32>(m_assets.size());
+}
+
+std::shared_ptr<const StaticAsset> StaticManager::loadAsset(const std::string& filePath)
+{
+    primus::component::filesystem::FileInfo info;
+    if (!primus::component::filesystem::getFileInfo(filePath, info))
+        return nullptr;
+
+    auto asset = std::make_shared<StaticAsset>();
+    asset->filePath      = filePath;
+    asset->contentType   = primus::mime::getContentType(filePath);
+    asset->contentLength = info.size;
+    asset->modified      = info.modified;
+    asset->lastModified  = primus::date::formatHttpDate(info.modified);
+    asset->data          = nullptr;
+
+    // Large files are not kept in memory. They are streamed from disk on every request
+    if (info.size > primus::constants::managers::manager_static::maxCachedFileSize)
+    {
+        const std::string version = filePath + ":" + std::to_string(info.modified) + ":" + std::to_string(info.size);
+        asset->etag         = "\"" + primus::hash::toHex(primus::hash::fnv1a64(version.data(), version.size())) + "\"";
+        asset->compressible = false;
+        return asset;
+    }
+
+    std::string content;
+    if (!readFile(filePath, info.size, content))
+    {
+        OATPP_LOGE(logName, "Failed to read file %s", filePath.c_str());
+        return nullptr;
+    }
+
+    asset->content       = oatpp::String(std::move(content));
+    asset->data          = asset->content->data();
+    asset->etag          = "\"" + primus::hash::toHex(primus::hash::fnv1a64(asset->content->data(), asset->content->size())) + "\"";
+    asset->compressible  = primus::mime::isCompressible(*asset->contentType);
+
+    if (asset->compressible)
+        loadVariants(*asset);
+
+    return asset;
+}
+
+#ifdef PRIMUS_EMBED_WEB_ASSETS
+std::shared_ptr<const StaticAsset> StaticManager::createEmbeddedAsset(const primus::embedded::EmbeddedAsset& embedded)
+{
+    // Only the metadata is copied, the content stays where it is in the executable
+    auto asset = std::make_shared<StaticAsset>();
+    asset->filePath      = embedded.path;
+    asset->data          = reinterpret_cast<const char*>(embedded.data);
+    asset->contentType   = embedded.contentType;
+    asset->contentLength = static_cast<v_int64>(embedded.size);
+    asset->modified      = embedded.modified;
+    asset->etag          = embedded.etag;
+    asset->lastModified  = embedded.lastModified;
+    asset->compressible  = primus::mime::isCompressible(embedded.contentType);
+
+    for (std::size_t i = 0; i < embedded.variantCount; ++i)
+    {
+        StaticAssetVariant variant;
+        variant.encoding      = embedded.variants[i].encoding;
+        variant.data          = reinterpret_cast<const char*>(embedded.variants[i].data);
+        variant.contentLength = static_cast<v_int64>(embedded.variants[i].size);
+        variant.etag          = embedded.variants[i].etag;
+        asset->variants.push_back(std::move(variant));
+    }
+
+    return asset;
+}
+#endif
+
+void StaticManager::loadVariants(StaticAsset& asset)
+{
+    // Most preferred encoding first
+    static const struct { const char* encoding; const char* extension; bool (*compress)(const std::string&, std::string&); } encoders[] =
+    {
+        { "br",   ".br", primus::compression::brotli },
+        { "gzip", ".gz", primus::compression::gzip   }
+    };
+
+    for (const auto& encoder : encoders)
+    {
+        std::string compressed;
+        bool loaded = false;
+
+        // A sibling produced by the build is only trusted as long as it is not older than the original
+        const std::string siblingPath = asset.filePath + encoder.extension;
+        primus::component::filesystem::FileInfo siblingInfo;
+        if (primus::component::filesystem::getFileInfo(siblingPath, siblingInfo) && siblingInfo.modified >= asset.modified)
+            loaded = readFile(siblingPath, siblingInfo.size, compressed);
+
+        if (!loaded && asset.contentLength >= primus::constants::managers::manager_static::minCompressSize)
+            loaded = encoder.compress(*asset.content, compressed);
+
+        // Keep the variant only if it actually saves bytes
+        if (!loaded || static_cast<v_int64>(compressed.size()) >= asset.contentLength)
+            continue;
+
+        StaticAssetVariant variant;
+        variant.encoding      = encoder.encoding;
+        variant.contentLength = static_cast<v_int64>(compressed.size());
+        variant.content       = oatpp::String(std::move(compressed));
+        variant.data          = variant.content->data();
+        variant.etag          = asset.etag->substr(0, asset.etag->size() - 1) + "-" + encoder.encoding + "\"";
+        asset.variants.push_back(std::move(variant));
+    }
+}
+
+bool StaticManager::readFile(const std::string& filePath, v_int64 size, std::string& content)
+{
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.good())
+        return false;
+
+    // Read straight into the final buffer, the content is never copied afterwards
+    content.assign(static_cast<std::size_t>(size), '\0');
+    return size == 0 || static_cast<bool>(file.read(&content[0], size));
+}
+
+const StaticAssetVariant* StaticManager::selectVariant(const StaticAsset& asset, const oatpp::String& acceptEncoding)
+{
+    if (asset.variants.empty() || !acceptEncoding)
+        return nullptr;
+
+    // Parse "br;q=1.0, gzip;q=0.8, *;q=0" into coding / quality pairs
+    std::vector<std::pair<std::string, double>> codings;
+    const std::string& header = *acceptEncoding;
+    std::size_t start = 0;
+
+    while (start < header.size())
+    {
+        std::size_t end = header.find(',', start);
+        if (end == std::string::npos)
+            end = header.size();
+
+        std::string token = header.substr(start, end - start);
+        double quality = 1.0;
+
+        const std::size_t paramPos = token.find(';');
+        if (paramPos != std::string::npos)
+        {
+            const std::size_t qPos = token.find("q=", paramPos);
+            if (qPos != std::string::npos)
+                quality = std::atof(token.c_str() + qPos + 2);
+            token.erase(paramPos);
+        }
+
+        token.erase(0, token.find_first_not_of(" \t"));
+        token.erase(token.find_last_not_of(" \t") + 1);
+        for (auto& c : token)
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+
+        if (!token.empty())
+            codings.emplace_back(token, quality);
+
+        start = end + 1;
+    }
+
+    auto qualityOf = [&codings](const std::string& coding, double fallback) -> double {
+        double wildcard = fallback;
+        for (const auto& entry : codings)
+        {
+            if (entry.first == coding)
+                return entry.second;
+            if (entry.first == "*")
+                wildcard = entry.second;
+        }
+        return wildcard;
+    };
+
+    const StaticAssetVariant* best = nullptr;
+    double bestQuality = 0.0;
+
+    for (const auto& variant : asset.variants)
+    {
+        const double quality = qualityOf(*variant.encoding, 0.0);
+        if (quality > bestQuality)
+        {
+            best = &variant;
+            bestQuality = quality;
+        }
+    }
+
+    // Identity is always acceptable unless excluded explicitly; on equal quality the smaller representation wins
+    if (best && qualityOf("identity", 1.0) > bestQuality)
+        return nullptr;
+
+    return best;
+}
+
+bool StaticManager::isSafePath(const std::string& relativePath)
+{
+    if (relativePath.find('\\') != std::string::npos || relativePath[0] == '/')
+        return false;
+
+    std::size_t start = 0;
+    while (start <= relativePath.size())
+    {
+        std::size_t end = relativePath.find('/', start);
+        if (end == std::string::npos)
+            end = relativePath.size();
+
+        if (relativePath.compare(start, end - start, "..") == 0)
+            return false;
+
+        start = end + 1;
+    }
+
+    return true;
+}
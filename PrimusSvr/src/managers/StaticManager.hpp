@@ -0,0 +1,167 @@
+#ifndef STATIC_MANAGER_HPP
+#define STATIC_MANAGER_HPP
+
+#include <map>
+#include <vector>
+#include <mutex>
+#include <chrono>
+#include <string>
+#include <memory>
+#include <ctime>
+
+#include "oatpp/core/Types.hpp"
+
+#include "general/constants.hpp"
+
+#ifdef PRIMUS_EMBED_WEB_ASSETS
+#include "general/EmbeddedAssets.hpp"
+#endif
+
+namespace primus {
+    namespace managers {
+        namespace Static {
+
+            /**
+             * @brief Compressed representation of a static file.
+             */
+            struct StaticAssetVariant
+            {
+                oatpp::String   encoding;       /**< Value of the Content-Encoding header, e.g. "br" or "gzip". */
+                oatpp::String   content;        /**< Compressed content. nullptr for embedded files. */
+                const char*     data;           /**< First byte of the compressed content, either in content or in the executable. */
+                v_int64         contentLength;  /**< Size of the compressed content in bytes. */
+                oatpp::String   etag;           /**< Entity tag of this representation. Differs from the one of the uncompressed content. */
+            };
+
+            /**
+             * @brief Immutable in-memory copy of a static file.
+             * Instances are shared between the cache and all responses serving them and are never modified after loading.
+             */
+            struct StaticAsset
+            {
+                std::string     filePath;       /**< Absolute path of the file on disk. Relative path for embedded files. */
+                oatpp::String   content;        /**< Content of the file. nullptr for embedded files and for large files, which are streamed from disk instead. */
+                const char*     data;           /**< First byte of the content, either in content or in the executable. nullptr for streamed files. */
+                oatpp::String   contentType;    /**< Precomputed value of the Content-Type header. */
+                v_int64         contentLength;  /**< Precomputed size of the content in bytes. */
+                std::time_t     modified;       /**< Modification time of the file at the time it was loaded. */
+                oatpp::String   etag;           /**< Strong entity tag. Hash of the content (or of size and modification time for streamed files), computed once per version of the file. */
+                oatpp::String   lastModified;   /**< Precomputed value of the Last-Modified header. */
+                bool            compressible;   /**< Whether the response depends on the Accept-Encoding header of the request. */
+                std::vector<StaticAssetVariant> variants; /**< Compressed variants, most preferred encoding first. Empty if compression is not worth it. */
+            };
+
+            /**
+             * @brief Manages the static web content and keeps it cached in memory.
+             * If the web assets are compiled into the executable (PRIMUS_EMBED_WEB_ASSETS) they are served from there and the directory is not used.
+             */
+            class StaticManager
+            {
+                using Asset = std::shared_ptr<const StaticAsset>;
+
+                static constexpr const char* logName = primus::constants::managers::manager_static::logName;
+
+                /**
+                 * @brief Cache entry of a single asset.
+                 */
+                struct CacheEntry
+                {
+                    Asset                                   asset;   /**< Currently cached version of the asset. */
+                    std::chrono::steady_clock::time_point   checked; /**< Last time the file was checked for modifications. */
+                };
+
+            private:
+                const std::string               m_directory;
+                std::map<std::string, CacheEntry> m_assets;
+                std::mutex                      m_lock;
+
+            private:
+                /**
+                 * @brief Constructor for the StaticManager class. Loads all files of the directory into the cache.
+                 * @param directory Directory to serve files from.
+                 */
+                explicit StaticManager(const std::string& directory);
+
+            public:
+                /**
+                 * @brief Destructor for the StaticManager class.
+                 */
+                virtual ~StaticManager(void) = default;
+
+                /**
+                 * @brief Creates a shared pointer to a StaticManager instance.
+                 * @param directory Directory to serve files from.
+                 * @return Shared pointer to the StaticManager instance.
+                 */
+                static std::shared_ptr<StaticManager> createShared(const std::string& directory);
+
+                /**
+                 * @brief Retrieves a file of the web directory.
+                 * Cached files are checked for modifications at most every few seconds and reloaded if they changed on disk.
+                 * @param relativePath Path of the file relative to the web directory. An empty path refers to index.html.
+                 * @return The cached file or nullptr if the file does not exist.
+                 */
+                Asset getAsset(const std::string& relativePath);
+
+                /**
+                 * @brief Drops all cached files and loads the web directory again.
+                 * @return Count of loaded files.
+                 */
+                v_uint32 reload(void);
+
+                /**
+                 * @brief Selects the representation of a file to send based on the Accept-Encoding header of the request.
+                 * The encoding with the highest quality value wins; on equal values the order of the variants decides.
+                 * @param asset File to serve.
+                 * @param acceptEncoding Value of the Accept-Encoding header. May be nullptr.
+                 * @return The variant to send or nullptr if the uncompressed content should be sent.
+                 */
+                static const StaticAssetVariant* selectVariant(const StaticAsset& asset, const oatpp::String& acceptEncoding);
+
+                /**
+                 * @brief Reads a file from disk. Large files are not read, only their metadata is collected.
+                 * @param filePath Absolute path of the file.
+                 * @return The loaded file or nullptr if the file could not be read.
+                 */
+                static Asset loadAsset(const std::string& filePath);
+
+            private:
+
+#ifdef PRIMUS_EMBED_WEB_ASSETS
+                /**
+                 * @brief Wraps a file embedded into the executable.
+                 * @param embedded Entry of the table of embedded files.
+                 * @return The file, referencing the embedded data.
+                 */
+                static Asset createEmbeddedAsset(const primus::embedded::EmbeddedAsset& embedded);
+#endif
+
+                /**
+                 * @brief Adds the compressed variants to a freshly loaded file.
+                 * Files compressed ahead of time (file.br / file.gz next to the file) are preferred over compressing at load time.
+                 * @param asset File to add the variants to.
+                 */
+                static void loadVariants(StaticAsset& asset);
+
+                /**
+                 * @brief Reads the whole content of a file.
+                 * @param filePath Absolute path of the file.
+                 * @param size Size of the file in bytes.
+                 * @param content Receives the content.
+                 * @return True on success.
+                 */
+                static bool readFile(const std::string& filePath, v_int64 size, std::string& content);
+
+                /**
+                 * @brief Checks whether a requested path stays within the web directory.
+                 * @param relativePath Requested path.
+                 * @return True if the path is safe to be served.
+                 */
+                static bool isSafePath(const std::string& relativePath);
+            };
+
+        } // namespace Static
+    } // namespace managers
+} // namespace primus
+
+#endif // STATIC_MANAGER_HPP
@@ -0,0 +1,373 @@
+#include "ThumbnailManager.hpp"
+
+#include <vector>
+#include <cstdio>
+
+#include "filesystemHelper.hpp"
+
+#ifdef PRIMUS_WITH_JPEG
+#include <csetjmp>
+#include <jpeglib.h>
+#endif
+
+using ThumbnailManager = primus::managers::Thumbnail::ThumbnailManager;
+using StaticManager    = primus::managers::Static::StaticManager;
+using StaticAsset      = primus::managers::Static::StaticAsset;
+
+namespace {
+#ifdef PRIMUS_WITH_JPEG
+    /**
+     * @brief Decoded picture with 3 bytes (RGB) per pixel.
+     */
+    struct Image
+    {
+        std::vector<unsigned char>  pixels;
+        unsigned int                width  = 0;
+        unsigned int                height = 0;
+    };
+
+    /**
+     * @brief Error handler of libjpeg. The default one terminates the process.
+     */
+    struct JpegError
+    {
+        jpeg_error_mgr  manager;
+        std::jmp_buf    jump;
+    };
+
+    void onJpegError(j_common_ptr info)
+    {
+        std::longjmp(reinterpret_cast<JpegError*>(info->err)->jump, 1);
+    }
+
+    void onJpegMessage(j_common_ptr)
+    {
+    }
+
+    /**
+     * @brief Decodes a JPEG file. The decoder drops detail right away as long as the shorter edge stays at least minEdge pixels long.
+     */
+    bool decodeJpeg(std::FILE* file, unsigned int minEdge, Image& image)
+    {
+        jpeg_decompress_struct info;
+        JpegError error;
+
+        info.err = jpeg_std_error(&error.manager);
+        error.manager.error_exit = onJpegError;
+        error.manager.output_message = onJpegMessage;
+
+        if (setjmp(error.jump))
+        {
+            jpeg_destroy_decompress(&info);
+            return false;
+        }
+
+        jpeg_create_decompress(&info);
+        jpeg_stdio_src(&info, file);
+        jpeg_read_header(&info, TRUE);
+
+        // DCT scaling: decoding at 1/2, 1/4 or 1/8 of the size is much cheaper than decoding everything and scaling afterwards
+        const unsigned int shorterEdge = info.image_width < info.image_height ? info.image_width : info.image_height;
+        unsigned int denominator = 1;
+        while (denominator < 8 && shorterEdge / (denominator * 2) >= minEdge)
+            denominator *= 2;
+
+        info.scale_num = 1;
+        info.scale_denom = denominator;
+        info.out_color_space = JCS_RGB;
+
+        jpeg_start_decompress(&info);
+
+        image.width = info.output_width;
+        image.height = info.output_height;
+        image.pixels.resize(static_cast<std::size_t>(image.width) * image.height * 3);
+
+        while (info.output_scanline < info.output_height)
+        {
+            JSAMPROW row = &image.pixels[static_cast<std::size_t>(info.output_scanline) * image.width * 3];
+            jpeg_read_scanlines(&info, &row, 1);
+        }
+
+        jpeg_finish_decompress(&info);
+        jpeg_destroy_decompress(&info);
+        return true;
+    }
+
+    /**
+     * @brief Encodes a square RGB picture as JPEG.
+     */
+    bool encodeJpeg(std::FILE* file, std::vector<unsigned char>& pixels, unsigned int edge)
+    {
+        jpeg_compress_struct info;
+        JpegError error;
+
+        info.err = jpeg_std_error(&error.manager);
+        error.manager.error_exit = onJpegError;
+        error.manager.output_message = onJpegMessage;
+
+        if (setjmp(error.jump))
+        {
+            jpeg_destroy_compress(&info);
+            return false;
+        }
+
+        jpeg_create_compress(&info);
+        jpeg_stdio_dest(&info, file);
+
+        info.image_width = edge;
+        info.image_height = edge;
+        info.input_components = 3;
+        info.in_color_space = JCS_RGB;
+
+        jpeg_set_defaults(&info);
+        jpeg_set_quality(&info, primus::constants::managers::manager_thumbnail::quality, TRUE);
+        jpeg_start_compress(&info, TRUE);
+
+        while (info.next_scanline < info.image_height)
+        {
+            JSAMPROW row = &pixels[static_cast<std::size_t>(info.next_scanline) * edge * 3];
+            jpeg_write_scanlines(&info, &row, 1);
+        }
+
+        jpeg_finish_compress(&info);
+        jpeg_destroy_compress(&info);
+        return true;
+    }
+
+    /**
+     * @brief Cuts the centered square out of a picture and scales it down by averaging the covered source pixels.
+     * Pictures smaller than the requested edge length are not scaled up.
+     */
+    std::vector<unsigned char> createSquare(const Image& image, unsigned int& edge)
+    {
+        const unsigned int square = image.width < image.height ? image.width : image.height;
+        const unsigned int left = (image.width - square) / 2;
+        const unsigned int top = (image.height - square) / 2;
+
+        if (edge > square)
+            edge = square;
+
+        std::vector<unsigned char> pixels(static_cast<std::size_t>(edge) * edge * 3);
+
+        for (unsigned int y = 0; y < edge; ++y)
+        {
+            const unsigned int y0 = top + static_cast<unsigned int>(static_cast<uint64_t>(y) * square / edge);
+            const unsigned int y1 = top + static_cast<unsigned int>(static_cast<uint64_t>(y + 1) * square / edge);
+
+            for (unsigned int x = 0; x < edge; ++x)
+            {
+                const unsigned int x0 = left + static_cast<unsigned int>(static_cast<uint64_t>(x) * square / edge);
+                const unsigned int x1 = left + static_cast<unsigned int>(static_cast<uint64_t>(x + 1) * square / edge);
+
+                uint64_t sum[3] = { 0, 0, 0 };
+                for (unsigned int sy = y0; sy < y1; ++sy)
+                {
+                    const unsigned char* pixel = &image.pixels[(static_cast<std::size_t>(sy) * image.width + x0) * 3];
+                    for (unsigned int sx = x0; sx < x1; ++sx, pixel += 3)
+                    {
+                        sum[0] += pixel[0];
+                        sum[1] += pixel[1];
+                        sum[2] += pixel[2];
+                    }
+                }
+
+                const uint64_t count = static_cast<uint64_t>(y1 - y0) * (x1 - x0);
+                unsigned char* target = &pixels[(static_cast<std::size_t>(y) * edge + x) * 3];
+                target[0] = static_cast<unsigned char>(sum[0] / count);
+                target[1] = static_cast<unsigned char>(sum[1] / count);
+                target[2] = static_cast<unsigned char>(sum[2] / count);
+            }
+        }
+
+        return pixels;
+    }
+#endif
+}
+
+ThumbnailManager::ThumbnailManager(void)
+    : m_stop(false)
+{
+    m_worker = std::thread(&ThumbnailManager::run, this);
+}
+
+ThumbnailManager::~ThumbnailManager(void)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_stop = true;
+    }
+
+    m_wakeup.notify_all();
+    m_worker.join();
+}
+
+std::shared_ptr<ThumbnailManager> ThumbnailManager::createShared(void)
+{
+    return std::shared_ptr<ThumbnailManager>(new ThumbnailManager());
+}
+
+v_uint32 ThumbnailManager::selectSize(v_uint32 requested)
+{
+    if (requested == 0)
+        return 0;
+
+    for (v_uint32 size : primus::constants::managers::manager_thumbnail::sizes)
+    {
+        if (size >= requested)
+            return size;
+    }
+
+    return 0;
+}
+
+std::string ThumbnailManager::getThumbnailPath(const std::string& sourcePath, v_uint32 size)
+{
+    const std::size_t slashPos = sourcePath.find_last_of('/');
+    const std::size_t dotPos = sourcePath.find_last_of('.');
+    const std::size_t stemEnd = (dotPos == std::string::npos || (slashPos != std::string::npos && dotPos < slashPos)) ? sourcePath.size() : dotPos;
+
+    return sourcePath.substr(0, stemEnd) + "-" + std::to_string(size) + ".jpg";
+}
+
+std::shared_ptr<const StaticAsset> ThumbnailManager::getThumbnail(const StaticAsset& source, v_uint32 size)
+{
+    const std::string path = getThumbnailPath(source.filePath, size);
+
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+
+        auto it = m_thumbnails.find(path);
+        if (it != m_thumbnails.end() && it->second.sourceModified == source.modified && it->second.sourceSize == source.contentLength)
+            return it->second.asset;
+    }
+
+    // A thumbnail older than its source belongs to a previous picture
+    primus::component::filesystem::FileInfo info;
+    if (primus::component::filesystem::getFileInfo(path, info) && info.modified >= source.modified)
+    {
+        Asset asset = StaticManager::loadAsset(path);
+        if (asset)
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            m_thumbnails[path] = CacheEntry{ asset, source.modified, source.contentLength };
+            return asset;
+        }
+    }
+
+    generate(source.filePath);
+    return nullptr;
+}
+
+void ThumbnailManager::generate(const std::string& sourcePath)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        if (!m_queued.insert(sourcePath).second)
+            return;
+
+        m_queue.push_back(sourcePath);
+    }
+
+    m_wakeup.notify_one();
+}
+
+void ThumbnailManager::invalidate(const std::string& sourcePath)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        for (v_uint32 size : primus::constants::managers::manager_thumbnail::sizes)
+            m_thumbnails.erase(getThumbnailPath(sourcePath, size));
+    }
+
+    for (v_uint32 size : primus::constants::managers::manager_thumbnail::sizes)
+        primus::component::filesystem::removeFile(getThumbnailPath(sourcePath, size));
+}
+
+void ThumbnailManager::run(void)
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+
+    while (true)
+    {
+        m_wakeup.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+        if (m_stop)
+            return;
+
+        // Leave the queued set right away, a picture replaced while it is processed gets queued again
+        const std::string sourcePath = m_queue.front();
+        m_queue.pop_front();
+        m_queued.erase(sourcePath);
+
+        lock.unlock();
+
+        primus::component::filesystem::FileInfo info;
+        const bool exists = primus::component::filesystem::getFileInfo(sourcePath, info);
+        const bool created = exists && createThumbnails(sourcePath);
+
+        if (created)
+            OATPP_LOGI(logName, "Created thumbnails of %s", sourcePath.c_str());
+        else if (exists)
+            OATPP_LOGW(logName, "Could not create thumbnails of %s. The original picture is served instead", sourcePath.c_str());
+
+        lock.lock();
+
+        for (v_uint32 size : primus::constants::managers::manager_thumbnail::sizes)
+        {
+            const std::string path = getThumbnailPath(sourcePath, size);
+
+            // Created thumbnails are picked up from disk by the next request. Failures are remembered per version of the source
+            if (created || !exists)
+                m_thumbnails.erase(path);
+            else
+                m_thumbnails[path] = CacheEntry{ nullptr, info.modified, info.size };
+        }
+    }
+}
+
+bool ThumbnailManager::createThumbnails(const std::string& sourcePath)
+{
+#ifdef PRIMUS_WITH_JPEG
+    const auto& sizes = primus::constants::managers::manager_thumbnail::sizes;
+    const unsigned int largestSize = sizes[sizeof(sizes) / sizeof(sizes[0]) - 1];
+
+    Image image;
+
+    std::FILE* source = primus::component::filesystem::openFile(sourcePath, "rb");
+    if (!source)
+        return false;
+
+    const bool decoded = decodeJpeg(source, largestSize, image);
+    std::fclose(source);
+
+    if (!decoded || image.width == 0 || image.height == 0)
+        return false;
+
+    for (v_uint32 size : sizes)
+    {
+        unsigned int edge = size;
+        std::vector<unsigned char> pixels = createSquare(image, edge);
+
+        // Write to a temporary file first, requests must never see a partially written thumbnail
+        const std::string path = getThumbnailPath(sourcePath, size);
+        const std::string temporaryPath = path + ".tmp";
+
+        std::FILE* target = primus::component::filesystem::openFile(temporaryPath, "wb");
+        if (!target)
+            return false;
+
+        const bool encoded = encodeJpeg(target, pixels, edge);
+        const bool closed = std::fclose(target) == 0;
+
+        if (!encoded || !closed || !primus::component::filesystem::replaceFile(temporaryPath, path))
+        {
+            primus::component::filesystem::removeFile(temporaryPath);
+            return false;
+        }
+    }
+
+    return true;
+#else
+    (void)sourcePath;
+    return false;
+#endif
+}
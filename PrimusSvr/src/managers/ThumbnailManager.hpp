@@ -0,0 +1,124 @@
+#ifndef THUMBNAIL_MANAGER_HPP
+#define THUMBNAIL_MANAGER_HPP
+
+#include <map>
+#include <set>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <string>
+#include <memory>
+#include <ctime>
+
+#include "oatpp/core/Types.hpp"
+
+#include "general/constants.hpp"
+#include "managers/StaticManager.hpp"
+
+namespace primus {
+    namespace managers {
+        namespace Thumbnail {
+
+            /**
+             * @brief Creates and caches downscaled variants of profile pictures.
+             * Thumbnails are square, stored next to their source as "<name>-<size>.jpg" and generated once by a background worker.
+             * Until a thumbnail is available the original picture has to be served.
+             */
+            class ThumbnailManager
+            {
+                using Asset = std::shared_ptr<const primus::managers::Static::StaticAsset>;
+
+                static constexpr const char* logName = primus::constants::managers::manager_thumbnail::logName;
+
+                /**
+                 * @brief Cache entry of a single thumbnail.
+                 */
+                struct CacheEntry
+                {
+                    Asset       asset;          /**< Loaded thumbnail. nullptr if it could not be created for this version of the source. */
+                    std::time_t sourceModified; /**< Modification time of the source the thumbnail was created from. */
+                    v_int64     sourceSize;     /**< Size of the source the thumbnail was created from. */
+                };
+
+            private:
+                std::map<std::string, CacheEntry>   m_thumbnails;
+                std::deque<std::string>             m_queue;
+                std::set<std::string>               m_queued;
+                std::mutex                          m_lock;
+                std::condition_variable             m_wakeup;
+                bool                                m_stop;
+                std::thread                         m_worker;
+
+            private:
+                /**
+                 * @brief Constructor for the ThumbnailManager class. Starts the background worker.
+                 */
+                ThumbnailManager(void);
+
+            public:
+                /**
+                 * @brief Destructor for the ThumbnailManager class. Stops the background worker, pending jobs are dropped.
+                 */
+                virtual ~ThumbnailManager(void);
+
+                /**
+                 * @brief Creates a shared pointer to a ThumbnailManager instance.
+                 * @return Shared pointer to the ThumbnailManager instance.
+                 */
+                static std::shared_ptr<ThumbnailManager> createShared(void);
+
+                /**
+                 * @brief Maps a requested size to the size of an available variant.
+                 * @param requested Requested edge length in pixels.
+                 * @return The smallest variant at least as large as requested, or 0 if the original picture should be served.
+                 */
+                static v_uint32 selectSize(v_uint32 requested);
+
+                /**
+                 * @brief Builds the path of a thumbnail.
+                 * @param sourcePath Path of the original picture.
+                 * @param size Edge length of the thumbnail.
+                 * @return Path of the thumbnail, whether it exists or not.
+                 */
+                static std::string getThumbnailPath(const std::string& sourcePath, v_uint32 size);
+
+                /**
+                 * @brief Retrieves a thumbnail of a picture. Missing or outdated thumbnails are scheduled for creation.
+                 * @param source Original picture.
+                 * @param size Edge length of the thumbnail as returned by selectSize.
+                 * @return The thumbnail or nullptr if it is not available (yet).
+                 */
+                Asset getThumbnail(const primus::managers::Static::StaticAsset& source, v_uint32 size);
+
+                /**
+                 * @brief Schedules the creation of all thumbnails of a picture, e.g. right after it was stored.
+                 * @param sourcePath Path of the original picture.
+                 */
+                void generate(const std::string& sourcePath);
+
+                /**
+                 * @brief Drops the cached and stored thumbnails of a picture.
+                 * @param sourcePath Path of the original picture.
+                 */
+                void invalidate(const std::string& sourcePath);
+
+            private:
+                /**
+                 * @brief Main loop of the background worker.
+                 */
+                void run(void);
+
+                /**
+                 * @brief Creates and stores all thumbnails of a picture.
+                 * @param sourcePath Path of the original picture.
+                 * @return True if all thumbnails were stored.
+                 */
+                static bool createThumbnails(const std::string& sourcePath);
+            };
+
+        } // namespace Thumbnail
+    } // namespace managers
+} // namespace primus
+
+#endif // THUMBNAIL_MANAGER_HPP
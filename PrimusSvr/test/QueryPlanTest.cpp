@@ -0,0 +1,273 @@
+/**
+ * @brief Checks the query plans of all DatabaseClient queries for full table scans.
+ * Applies the migrations to an in-memory database, runs EXPLAIN QUERY PLAN on every QUERY and every cached statement of
+ * DatabaseClient.hpp and fails if a plan scans a table, unless the query is listed in expectedScans.
+ *
+ * Usage: QueryPlanTest <DatabaseClient.hpp> <migration>...
+ */
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <regex>
+
+#include "oatpp-sqlite/orm.hpp"
+
+namespace {
+    /**
+     * @brief Queries which read a whole table by design, with the reason.
+     */
+    const std::map<std::string, std::string> expectedScans = {
+        { "getAllMemberIds",    "Loads all ids into the MemberRegistry once at startup" },
+        { "getAllAttendances",  "Loads all attendances into the AttendanceIndex once at startup" },
+        { "getAllMembers",      "Lists all members in id order, the LIMIT stops the scan" },
+        { "rebuildStats",       "Recounts all members and attendances, run on request only" },
+        { "rebuildMemberStats", "Recounts the attendances of all members, run on request only" },
+    };
+
+    struct Query
+    {
+        std::string name;
+        std::string sql;
+    };
+
+    /**
+     * @brief Reads a whole file.
+     */
+    bool readFile(const std::string& path, std::string& content)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.good())
+            return false;
+
+        std::ostringstream stream;
+        stream << file.rdbuf();
+        content = stream.str();
+        return true;
+    }
+
+    void skipWhitespace(const std::string& text, std::size_t& pos)
+    {
+        while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos])))
+            ++pos;
+    }
+
+    /**
+     * @brief Reads adjacent string literals, e.g. the lines of a query, and concatenates them.
+     * @param pos Position of the first literal. Receives the position behind the last one.
+     */
+    std::string readLiterals(const std::string& text, std::size_t& pos)
+    {
+        std::string value;
+
+        skipWhitespace(text, pos);
+        while (pos < text.size() && text[pos] == '"')
+        {
+            for (++pos; pos < text.size() && text[pos] != '"'; ++pos)
+            {
+                if (text[pos] == '\\' && pos + 1 < text.size())
+                {
+                    ++pos;
+                    value += text[pos] == 'n' ? '\n' : text[pos] == 't' ? '\t' : text[pos];
+                }
+                else
+                    value += text[pos];
+            }
+
+            ++pos;
+            skipWhitespace(text, pos);
+        }
+
+        return value;
+    }
+
+    /**
+     * @brief Collects the QUERY macros and the cached statements of the DatabaseClient.
+     */
+    std::vector<Query> collectQueries(const std::string& source)
+    {
+        std::vector<Query> queries;
+
+        for (std::size_t pos = source.find("QUERY("); pos != std::string::npos; pos = source.find("QUERY(", pos))
+        {
+            pos += std::strlen("QUERY(");
+
+            const std::size_t comma = source.find(',', pos);
+            if (comma == std::string::npos)
+                break;
+
+            Query query;
+            query.name = source.substr(pos, comma - pos);
+            query.name.erase(0, query.name.find_first_not_of(" \t\r\n"));
+            query.name.erase(query.name.find_last_not_of(" \t\r\n") + 1);
+
+            pos = comma + 1;
+            query.sql = readLiterals(source, pos);
+            queries.push_back(query);
+        }
+
+        for (std::size_t pos = source.find("executeCached("); pos != std::string::npos; pos = source.find("executeCached(", pos))
+        {
+            pos += std::strlen("executeCached(");
+
+            Query query;
+            query.name = readLiterals(source, pos);
+            if (pos >= source.size() || source[pos] != ',')
+                continue;
+
+            ++pos;
+            query.sql = readLiterals(source, pos);
+            queries.push_back(query);
+        }
+
+        return queries;
+    }
+
+    /**
+     * @brief Replaces the parameters of oatpp (:name and :dto.field) by anonymous SQLite parameters.
+     */
+    std::string replaceParameters(const std::string& sql)
+    {
+        std::string result;
+        bool quoted = false;
+
+        for (std::size_t i = 0; i < sql.size(); ++i)
+        {
+            if (sql[i] == '\'')
+                quoted = !quoted;
+
+            if (!quoted && sql[i] == ':' && i + 1 < sql.size() && (std::isalpha(static_cast<unsigned char>(sql[i + 1])) || sql[i + 1] == '_'))
+            {
+                while (i + 1 < sql.size() && (std::isalnum(static_cast<unsigned char>(sql[i + 1])) || sql[i + 1] == '_' || sql[i + 1] == '.'))
+                    ++i;
+
+                result += '?';
+                continue;
+            }
+
+            result += sql[i];
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Checks whether a name is a common table expression or a subquery of the query, scanning their results is fine.
+     */
+    bool isSubquery(const std::string& sql, const std::string& name)
+    {
+        const std::regex commonTableExpression("\\b" + name + "\\s*(\\([^)]*\\))?\\s+AS\\s*(NOT\\s+)?(MATERIALIZED\\s*)?\\(", std::regex::icase);
+        const std::regex subquery("\\)\\s*(AS\\s+)?" + name + "\\b", std::regex::icase);
+        return std::regex_search(sql, commonTableExpression) || std::regex_search(sql, subquery);
+    }
+
+    /**
+     * @brief Collects the full table scans of a plan.
+     * @return The plan lines scanning a table.
+     */
+    std::vector<std::string> findScans(sqlite3* database, const Query& query, std::string& error)
+    {
+        std::vector<std::string> scans;
+
+        const std::string sql = "EXPLAIN QUERY PLAN " + replaceParameters(query.sql);
+        sqlite3_stmt* statement = nullptr;
+
+        if (sqlite3_prepare_v2(database, sql.c_str(), -1, &statement, nullptr) != SQLITE_OK)
+        {
+            error = sqlite3_errmsg(database);
+            sqlite3_finalize(statement);
+            return scans;
+        }
+
+        while (sqlite3_step(statement) == SQLITE_ROW)
+        {
+            const char* text = reinterpret_cast<const char*>(sqlite3_column_text(statement, 3));
+            const std::string detail = text ? text : "";
+
+            if (detail.compare(0, 5, "SCAN ") != 0 || detail.find("CONSTANT ROW") != std::string::npos)
+                continue;
+
+            // Older versions of SQLite print "SCAN TABLE <name>", newer ones "SCAN <name>"
+            std::string target = detail.substr(5);
+            if (target.compare(0, 6, "TABLE ") == 0)
+                target.erase(0, 6);
+            target = target.substr(0, target.find(' '));
+
+            if (target.empty() || target[0] == '(' || isSubquery(query.sql, target))
+                continue;
+
+            scans.push_back(detail);
+        }
+
+        sqlite3_finalize(statement);
+        return scans;
+    }
+}
+
+int main(int argc, const char* argv[])
+{
+    if (argc < 3)
+    {
+        std::cerr << "Usage: QueryPlanTest <DatabaseClient.hpp> <migration>..." << std::endl;
+        return 2;
+    }
+
+    std::string source;
+    if (!readFile(argv[1], source))
+    {
+        std::cerr << "Failed to read " << argv[1] << std::endl;
+        return 2;
+    }
+
+    sqlite3* database = nullptr;
+    if (sqlite3_open(":memory:", &database) != SQLITE_OK)
+    {
+        std::cerr << "Failed to open the in-memory database" << std::endl;
+        return 2;
+    }
+
+    for (int i = 2; i < argc; ++i)
+    {
+        std::string migration;
+        char* message = nullptr;
+
+        if (!readFile(argv[i], migration) || sqlite3_exec(database, migration.c_str(), nullptr, nullptr, &message) != SQLITE_OK)
+        {
+            std::cerr << "Failed to apply " << argv[i] << ": " << (message ? message : "not readable") << std::endl;
+            sqlite3_free(message);
+            sqlite3_close(database);
+            return 2;
+        }
+    }
+
+    const std::vector<Query> queries = collectQueries(source);
+    int failures = 0;
+
+    for (const Query& query : queries)
+    {
+        std::string error;
+        const std::vector<std::string> scans = findScans(database, query, error);
+
+        if (!error.empty())
+        {
+            std::cerr << "FAIL " << query.name << ": " << error << std::endl;
+            ++failures;
+        }
+        else if (!scans.empty() && expectedScans.find(query.name) == expectedScans.end())
+        {
+            std::cerr << "FAIL " << query.name << " scans a table:" << std::endl;
+            for (const std::string& scan : scans)
+                std::cerr << "    " << scan << std::endl;
+            ++failures;
+        }
+    }
+
+    sqlite3_close(database);
+
+    std::cout << "Checked the plans of " << queries.size() << " queries, " << failures << " failed" << std::endl;
+    return queries.empty() || failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,212 @@
+/**
+ * @brief Build time generator for PRIMUS_EMBED_WEB_ASSETS.
+ * Compiles all files of the web directory into a C++ source file defining primus::embedded::assets (see general/EmbeddedAssets.hpp).
+ * Entity tags, MIME types and compressed variants are computed exactly like StaticManager does it at runtime.
+ *
+ * Usage: EmbedAssets <web directory> <output file>
+ */
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <set>
+#include <algorithm>
+
+#include "filesystemHelper.hpp"
+#include "general/constants.hpp"
+#include "general/mime.hpp"
+#include "general/hash.hpp"
+#include "general/compression.hpp"
+#include "general/date.hpp"
+
+namespace {
+    /**
+     * @brief Checks whether a string ends with the given suffix.
+     */
+    bool endsWith(const std::string& value, const std::string& suffix)
+    {
+        return value.size() >= suffix.size() && value.compare(value.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+
+    /**
+     * @brief Reads a whole file.
+     */
+    bool readFile(const std::string& path, std::string& content)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.good())
+            return false;
+
+        std::ostringstream buffer;
+        buffer << file.rdbuf();
+        content = buffer.str();
+        return true;
+    }
+
+    /**
+     * @brief Escapes a string for use in a C++ string literal.
+     */
+    std::string quote(const std::string& value)
+    {
+        std::string quoted = "\"";
+        for (char c : value)
+        {
+            if (c == '"' || c == '\\')
+                quoted += '\\';
+            quoted += c;
+        }
+        return quoted + "\"";
+    }
+
+    /**
+     * @brief Writes a byte array definition.
+     */
+    void writeArray(std::ostream& out, const std::string& name, const std::string& content)
+    {
+        out << "    constexpr unsigned char " << name << "[] = {";
+
+        // Empty arrays are not allowed, the size stored next to the pointer stays 0 anyway
+        if (content.empty())
+            out << " 0";
+
+        for (std::size_t i = 0; i < content.size(); ++i)
+        {
+            if (i % 24 == 0)
+                out << "\n        ";
+            out << static_cast<unsigned int>(static_cast<unsigned char>(content[i])) << ",";
+        }
+
+        out << "\n    };\n";
+    }
+
+    /**
+     * @brief Variant of a file as it is written to the table.
+     */
+    struct Variant
+    {
+        const char* encoding;
+        std::string arrayName;
+        std::size_t size;
+        std::string etag;
+    };
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc != 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " <web directory> <output file>" << std::endl;
+        return 1;
+    }
+
+    const std::string directory = argv[1];
+    const std::string outputPath = argv[2];
+
+    std::vector<std::string> files;
+    primus::component::filesystem::listFilesRecursive(directory, "", files);
+    std::sort(files.begin(), files.end());
+
+    const std::set<std::string> fileSet(files.begin(), files.end());
+
+    // Same order and rules as StaticManager::loadVariants
+    static const struct { const char* encoding; const char* extension; bool (*compress)(const std::string&, std::string&); } encoders[] =
+    {
+        { "br",   ".br", primus::compression::brotli },
+        { "gzip", ".gz", primus::compression::gzip   }
+    };
+
+    std::ostringstream arrays;
+    std::ostringstream table;
+    std::size_t count = 0;
+
+    for (const auto& file : files)
+    {
+        if ((endsWith(file, ".gz") || endsWith(file, ".br")) && fileSet.count(file.substr(0, file.size() - 3)) != 0)
+            continue;
+
+        const std::string filePath = directory + "/" + file;
+
+        primus::component::filesystem::FileInfo info;
+        std::string content;
+        if (!primus::component::filesystem::getFileInfo(filePath, info) || !readFile(filePath, content))
+        {
+            std::cerr << "Failed to read " << filePath << std::endl;
+            return 1;
+        }
+
+        const std::string name = "asset" + std::to_string(count);
+        const char* contentType = primus::mime::getContentType(filePath);
+        const std::string etag = "\"" + primus::hash::toHex(primus::hash::fnv1a64(content.data(), content.size())) + "\"";
+
+        writeArray(arrays, name, content);
+
+        std::vector<Variant> variants;
+        if (primus::mime::isCompressible(contentType))
+        {
+            for (const auto& encoder : encoders)
+            {
+                std::string compressed;
+                bool loaded = false;
+
+                primus::component::filesystem::FileInfo siblingInfo;
+                if (primus::component::filesystem::getFileInfo(filePath + encoder.extension, siblingInfo) && siblingInfo.modified >= info.modified)
+                    loaded = readFile(filePath + encoder.extension, compressed);
+
+                if (!loaded && static_cast<long long>(content.size()) >= primus::constants::managers::manager_static::minCompressSize)
+                    loaded = encoder.compress(content, compressed);
+
+                if (!loaded || compressed.size() >= content.size())
+                    continue;
+
+                Variant variant{ encoder.encoding, name + "_" + encoder.encoding, compressed.size(), etag.substr(0, etag.size() - 1) + "-" + encoder.encoding + "\"" };
+                writeArray(arrays, variant.arrayName, compressed);
+                variants.push_back(variant);
+            }
+        }
+
+        if (!variants.empty())
+        {
+            arrays << "    const primus::embedded::EmbeddedVariant " << name << "_variants[] = {\n";
+            for (const auto& variant : variants)
+                arrays << "        { " << quote(variant.encoding) << ", " << variant.arrayName << ", " << variant.size << ", " << quote(variant.etag) << " },\n";
+            arrays << "    };\n";
+        }
+
+        table << "            { " << quote(file) << ", " << name << ", " << content.size() << ", " << quote(contentType) << ", "
+              << quote(etag) << ", " << quote(primus::date::formatHttpDate(info.modified)) << ", " << static_cast<long long>(info.modified) << ", "
+              << (variants.empty() ? std::string("nullptr") : name + "_variants") << ", " << variants.size() << " },\n";
+
+        std::cout << "Embedding " << file << " (" << content.size() << " bytes, " << variants.size() << " compressed variants)" << std::endl;
+        ++count;
+    }
+
+    // Empty arrays are not allowed. The dummy entry is never visible, assetCount stays 0
+    if (count == 0)
+        table << "            { \"\", nullptr, 0, \"\", \"\", \"\", 0, nullptr, 0 },\n";
+
+    std::ostringstream out;
+    out << "// Generated by EmbedAssets from " << directory << ". Do not edit.\n"
+        << "#include \"general/EmbeddedAssets.hpp\"\n\n"
+        << "namespace {\n" << arrays.str() << "}\n\n"
+        << "namespace primus {\n"
+        << "    namespace embedded {\n"
+        << "        extern const EmbeddedAsset assets[] = {\n" << table.str() << "        };\n\n"
+        << "        extern const std::size_t assetCount = " << count << ";\n"
+        << "    } // Namespace embedded\n"
+        << "} // Namespace primus\n";
+
+    std::ofstream output(outputPath, std::ios::binary | std::ios::trunc);
+    output << out.str();
+    output.close();
+
+    if (!output)
+    {
+        std::cerr << "Failed to write " << outputPath << std::endl;
+        return 1;
+    }
+
+    return 0;
+}